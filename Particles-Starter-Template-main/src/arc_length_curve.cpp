@@ -0,0 +1,109 @@
+#include "arc_length_curve.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Cordes par intervalle de la table : la longueur d'une ligne brisée sous-estime celle de la courbe, l'erreur
+// décroît comme le carré du pas
+static constexpr int chords_per_sample = 8;
+
+ArcLengthCurve::ArcLengthCurve(std::function<glm::vec2(float)> parametric, int samples)
+    : _parametric{std::move(parametric)}
+{
+    samples = std::max(samples, 1);
+    _closed = glm::distance(_parametric(0.f), _parametric(1.f)) < 1e-6f;
+
+    // Longueurs cumulées en double : des milliers de petites cordes s'additionnent sans perte de précision
+    _lengths.resize(static_cast<size_t>(samples) + 1);
+    _lengths[0]        = 0.f;
+    double    total    = 0.;
+    glm::vec2 previous = _parametric(0.f);
+    for (int i = 0; i < samples; ++i)
+    {
+        for (int chord = 1; chord <= chords_per_sample; ++chord)
+        {
+            glm::vec2 const point = _parametric((static_cast<float>(i) + static_cast<float>(chord) / chords_per_sample) / static_cast<float>(samples));
+            total += glm::distance(previous, point);
+            previous = point;
+        }
+        _lengths[static_cast<size_t>(i) + 1] = static_cast<float>(total);
+    }
+
+    // Case k : dernier intervalle qui commence avant s = k · length() / samples
+    _buckets.resize(static_cast<size_t>(samples) + 1);
+    uint32_t interval = 0;
+    for (size_t k = 0; k < _buckets.size(); ++k)
+    {
+        float const s = length() * static_cast<float>(k) / static_cast<float>(samples);
+        while (interval + 1 < static_cast<uint32_t>(samples) && _lengths[interval + 1] <= s)
+            ++interval;
+        _buckets[k] = interval;
+    }
+}
+
+float ArcLengthCurve::wrap_length(float s) const
+{
+    float const total = length();
+    if (_closed && total > 0.f)
+        s -= total * std::floor(s / total);
+    return std::clamp(s, 0.f, total);
+}
+
+float ArcLengthCurve::t_at_length(float s) const
+{
+    s                    = wrap_length(s);
+    size_t const samples = _lengths.size() - 1;
+    float const  total   = length();
+    if (total <= 0.f)
+        return 0.f;
+
+    size_t const bucket   = std::min(static_cast<size_t>(s / total * static_cast<float>(samples)), samples);
+    size_t       interval = _buckets[bucket];
+    // Une case couvre length() / samples : en moyenne moins d'un intervalle à sauter
+    while (interval + 1 < samples && _lengths[interval + 1] <= s)
+        ++interval;
+
+    float const interval_length = _lengths[interval + 1] - _lengths[interval];
+    float const fraction        = interval_length > 0.f ? std::clamp((s - _lengths[interval]) / interval_length, 0.f, 1.f) : 0.f;
+    return (static_cast<float>(interval) + fraction) / static_cast<float>(samples);
+}
+
+float ArcLengthCurve::length_at_t(float t) const
+{
+    size_t const samples  = _lengths.size() - 1;
+    float const  position = std::clamp(t, 0.f, 1.f) * static_cast<float>(samples);
+    size_t const interval = std::min(static_cast<size_t>(position), samples - 1);
+    float const  fraction = position - static_cast<float>(interval);
+    return _lengths[interval] + fraction * (_lengths[interval + 1] - _lengths[interval]);
+}
+
+glm::vec2 ArcLengthCurve::position_at_length(float s) const
+{
+    return _parametric(t_at_length(s));
+}
+
+glm::vec2 ArcLengthCurve::position_at_fraction(float u) const
+{
+    return position_at_length(u * length());
+}
+
+std::vector<glm::vec2> ArcLengthCurve::uniform_points(int segments) const
+{
+    segments = std::max(segments, 1);
+    std::vector<glm::vec2> points(static_cast<size_t>(segments) + 1);
+    for (int i = 0; i <= segments; ++i)
+        points[static_cast<size_t>(i)] = position_at_fraction(static_cast<float>(i) / static_cast<float>(segments));
+    if (_closed)
+        points.back() = points.front();
+    return points;
+}
+
+void ArcLengthCurve::warp(std::span<float const> u, std::span<float> x, std::span<float> y) const
+{
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        glm::vec2 const point = position_at_fraction(u[i]);
+        x[i]                  = point.x;
+        y[i]                  = point.y;
+    }
+}
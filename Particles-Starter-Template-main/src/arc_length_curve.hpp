@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Paramétrage par la longueur d'arc d'une courbe paramétrique t ∈ [0, 1] (heart_curve(), courbes de Bézier, ...).
+// Un t uniforme serre les points là où la courbe va lentement et les espace là où elle va vite : pour la même
+// précision, il faut beaucoup plus de segments. La table des longueurs cumulées est calculée une fois ; s -> t coûte
+// ensuite O(1) : des cases régulières en s donnent l'intervalle de la table, puis on interpole linéairement.
+// Une courbe fermée (même point en t = 0 et t = 1) est parcourue en boucle : s est pris modulo length().
+class ArcLengthCurve {
+public:
+    // La table découpe [0, 1] en samples intervalles de t, chacun mesuré par une ligne brisée de quelques cordes
+    explicit ArcLengthCurve(std::function<glm::vec2(float)> parametric, int samples = 1024);
+
+    float length() const { return _lengths.back(); }
+    bool  closed() const { return _closed; }
+
+    // t du point à la distance s du début, le long de la courbe (s ramené dans [0, length()])
+    float t_at_length(float s) const;
+    // Longueur de la courbe entre t = 0 et t
+    float length_at_t(float t) const;
+
+    glm::vec2 position_at_length(float s) const;
+    // Point à la fraction u ∈ [0, 1] de la longueur : même courbe que parametric, parcourue à vitesse constante
+    glm::vec2 position_at_fraction(float u) const;
+
+    // segments + 1 points régulièrement espacés le long de la courbe (le dernier est le premier si elle est fermée)
+    std::vector<glm::vec2> uniform_points(int segments) const;
+
+    // Comme les warps de samplers.hpp : u[i] ∈ [0, 1) -> point à la fraction u[i] de la longueur.
+    // Des u uniformes donnent des points uniformes le long de la courbe ; u peut être le même tableau que x.
+    void warp(std::span<float const> u, std::span<float> x, std::span<float> y) const;
+
+private:
+    // Ramène s dans [0, length()] : modulo pour une courbe fermée, borné sinon
+    float wrap_length(float s) const;
+
+private:
+    std::function<glm::vec2(float)> _parametric;
+    bool                            _closed;
+    std::vector<float>              _lengths{}; // Longueur cumulée en t = i / samples (samples + 1 valeurs)
+    std::vector<uint32_t>           _buckets{}; // Intervalle de la table qui contient s = k · length() / samples
+};
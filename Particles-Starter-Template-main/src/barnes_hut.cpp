@@ -0,0 +1,319 @@
+#include "barnes_hut.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include "thread_pool.hpp"
+
+static constexpr size_t   particles_per_task = 16384;
+static constexpr uint32_t leaf_size          = 8;  // Au-delà, une cellule est découpée
+static constexpr int      max_level          = 16; // 16 bits par axe dans les codes de Morton
+static constexpr int      parallel_level     = 3;  // Les 4³ sous-arbres de ce niveau sont construits en parallèle
+
+// Intercale les bits de x et y : yxyx...yx
+static uint32_t morton_code(uint32_t x, uint32_t y)
+{
+    auto spread = [](uint32_t v) {
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+// Quadrant (0 à 3) d'un code au niveau level : bit x = 1 à droite, bit y = 2 en haut
+static uint32_t quadrant(uint32_t code, int level)
+{
+    return (code >> (30 - 2 * level)) & 3u;
+}
+
+void BarnesHutTree::sort_by_morton_code(size_t count)
+{
+    // Tri par base (4 passes de 8 bits), stable. Le découpage en tranches ne dépend que de count :
+    // le résultat est le même quel que soit le nombre de threads.
+    size_t const chunks_count = (count + particles_per_task - 1) / particles_per_task;
+    _codes_scratch.resize(count);
+    _order_scratch.resize(count);
+    _histograms.resize(chunks_count * 256);
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        std::fill(_histograms.begin(), _histograms.end(), 0u);
+        thread_pool().parallel_for(count, particles_per_task, [&](size_t begin, size_t end) {
+            uint32_t* histogram = &_histograms[begin / particles_per_task * 256];
+            for (size_t i = begin; i < end; ++i)
+                ++histogram[(_codes[i] >> shift) & 0xFFu];
+        });
+
+        // Position de départ de chaque (chiffre, tranche), chiffre par chiffre puis tranche par tranche
+        uint32_t offset = 0;
+        for (size_t digit = 0; digit < 256; ++digit)
+        {
+            for (size_t chunk = 0; chunk < chunks_count; ++chunk)
+            {
+                uint32_t const chunk_count       = _histograms[chunk * 256 + digit];
+                _histograms[chunk * 256 + digit] = offset;
+                offset += chunk_count;
+            }
+        }
+
+        thread_pool().parallel_for(count, particles_per_task, [&](size_t begin, size_t end) {
+            uint32_t* cursor = &_histograms[begin / particles_per_task * 256];
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint32_t const destination = cursor[(_codes[i] >> shift) & 0xFFu]++;
+                _codes_scratch[destination] = _codes[i];
+                _order_scratch[destination] = _order[i];
+            }
+        });
+        std::swap(_codes, _codes_scratch);
+        std::swap(_order, _order_scratch);
+    }
+}
+
+void BarnesHutTree::build(std::span<float const> x, std::span<float const> y)
+{
+    size_t const count = x.size();
+    _nodes.clear();
+    if (count == 0)
+        return;
+
+    // Boîte englobante, une par tranche puis réduite
+    size_t const           chunks_count = (count + particles_per_task - 1) / particles_per_task;
+    std::vector<glm::vec4> chunk_bounds(chunks_count);
+    thread_pool().parallel_for(count, particles_per_task, [&](size_t begin, size_t end) {
+        glm::vec2 min{std::numeric_limits<float>::max()};
+        glm::vec2 max{std::numeric_limits<float>::lowest()};
+        for (size_t i = begin; i < end; ++i)
+        {
+            min = glm::min(min, glm::vec2{x[i], y[i]});
+            max = glm::max(max, glm::vec2{x[i], y[i]});
+        }
+        chunk_bounds[begin / particles_per_task] = glm::vec4{min, max};
+    });
+    glm::vec2 min{std::numeric_limits<float>::max()};
+    glm::vec2 max{std::numeric_limits<float>::lowest()};
+    for (glm::vec4 const& bounds : chunk_bounds)
+    {
+        min = glm::min(min, glm::vec2{bounds.x, bounds.y});
+        max = glm::max(max, glm::vec2{bounds.z, bounds.w});
+    }
+    // Racine carrée, un peu plus grande que la boîte pour que le point max tombe dans la dernière case
+    _root_size = std::max(max.x - min.x, max.y - min.y) * 1.0001f + 1e-6f;
+
+    _codes.resize(count);
+    _order.resize(count);
+    float const scale = 65536.f / _root_size;
+    thread_pool().parallel_for(count, particles_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto const quantize = [&](float value, float origin) {
+                return static_cast<uint32_t>(std::clamp((value - origin) * scale, 0.f, 65535.f));
+            };
+            _codes[i] = morton_code(quantize(x[i], min.x), quantize(y[i], min.y));
+            _order[i] = static_cast<uint32_t>(i);
+        }
+    });
+    sort_by_morton_code(count);
+
+    _sorted_x.resize(count);
+    _sorted_y.resize(count);
+    thread_pool().parallel_for(count, particles_per_task, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            _sorted_x[k] = x[_order[k]];
+            _sorted_y[k] = y[_order[k]];
+        }
+    });
+
+    // Haut de l'arbre en série, jusqu'à parallel_level ; les cellules de ce niveau sont mises de côté
+    struct PendingSubtree {
+        uint32_t  begin;
+        uint32_t  end;
+        glm::vec2 min;
+        int32_t   parent;
+        int       child;
+    };
+    std::vector<PendingSubtree> pending{};
+
+    auto const build_top = [&](auto const& self, uint32_t begin, uint32_t end, int level, glm::vec2 cell_min) -> int32_t {
+        uint32_t   ranges[5];
+        auto const index = static_cast<int32_t>(_nodes.size());
+        _nodes.push_back(make_node(begin, end, level, cell_min, ranges));
+        if (_nodes.back().children[0] == -2)
+        {
+            _nodes.back().children[0] = -1;
+            return index;
+        }
+        float const child_size = _nodes.back().size / 2.f;
+        for (int c = 0; c < 4; ++c)
+        {
+            int32_t child = -1;
+            if (ranges[c] < ranges[c + 1])
+            {
+                glm::vec2 const child_min = cell_min + child_size * glm::vec2{c & 1, c >> 1};
+                if (level + 1 == parallel_level)
+                    pending.push_back({ranges[c], ranges[c + 1], child_min, index, c});
+                else
+                    child = self(self, ranges[c], ranges[c + 1], level + 1, child_min);
+            }
+            _nodes[static_cast<size_t>(index)].children[c] = child;
+        }
+        return index;
+    };
+    build_top(build_top, 0, static_cast<uint32_t>(count), 0, min);
+    size_t const top_count = _nodes.size();
+
+    // Sous-arbres en parallèle, chacun dans son propre tableau, puis recopiés à la suite
+    std::vector<std::vector<Node>> subtrees(pending.size());
+    thread_pool().parallel_for(pending.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+            build_subtree(pending[k].begin, pending[k].end, parallel_level, pending[k].min, subtrees[k]);
+    });
+    for (size_t k = 0; k < pending.size(); ++k)
+    {
+        auto const offset = static_cast<int32_t>(_nodes.size());
+        for (Node node : subtrees[k])
+        {
+            for (int32_t& child : node.children)
+                child = child >= 0 ? child + offset : child;
+            _nodes.push_back(node);
+        }
+        _nodes[static_cast<size_t>(pending[k].parent)].children[pending[k].child] = offset; // La racine d'un sous-arbre est son premier nœud
+    }
+
+    // Les nœuds du haut ont été créés avant leurs enfants : on remonte dans l'ordre inverse
+    for (size_t i = top_count; i-- > 0;)
+        compute_mass(_nodes[i], _nodes);
+}
+
+BarnesHutTree::Node BarnesHutTree::make_node(uint32_t begin, uint32_t end, int level, glm::vec2 min, uint32_t (&children_ranges)[5]) const
+{
+    Node node{
+        .min            = min,
+        .size           = _root_size / static_cast<float>(1u << level),
+        .mass           = 0.f,
+        .center_of_mass = glm::vec2{0.f},
+        .begin          = begin,
+        .end            = end,
+        .children       = {-1, -1, -1, -1},
+    };
+    if (end - begin <= leaf_size || level == max_level)
+    {
+        node.children[0] = -2; // Marqueur temporaire : feuille (remis à -1 par l'appelant)
+        return node;
+    }
+
+    // Les codes de la cellule partagent leurs 2·level premiers bits : les quatre quadrants sont contigus
+    children_ranges[0] = begin;
+    for (uint32_t c = 1; c < 4; ++c)
+    {
+        auto const first = std::partition_point(_codes.begin() + children_ranges[c - 1], _codes.begin() + end, [&](uint32_t code) {
+            return quadrant(code, level) < c;
+        });
+        children_ranges[c] = static_cast<uint32_t>(first - _codes.begin());
+    }
+    children_ranges[4] = end;
+    return node;
+}
+
+void BarnesHutTree::compute_mass(Node& node, std::vector<Node> const& nodes) const
+{
+    node.mass           = 0.f;
+    node.center_of_mass = glm::vec2{0.f};
+    bool leaf           = true;
+    for (int32_t child : node.children)
+    {
+        if (child < 0)
+            continue;
+        leaf = false;
+        node.mass += nodes[static_cast<size_t>(child)].mass;
+        node.center_of_mass += nodes[static_cast<size_t>(child)].mass * nodes[static_cast<size_t>(child)].center_of_mass;
+    }
+    if (leaf)
+    {
+        for (uint32_t k = node.begin; k < node.end; ++k)
+            node.center_of_mass += glm::vec2{_sorted_x[k], _sorted_y[k]};
+        node.mass = static_cast<float>(node.end - node.begin);
+    }
+    node.center_of_mass /= node.mass;
+}
+
+int32_t BarnesHutTree::build_subtree(uint32_t begin, uint32_t end, int level, glm::vec2 min, std::vector<Node>& nodes) const
+{
+    uint32_t   ranges[5];
+    auto const index = static_cast<int32_t>(nodes.size());
+    nodes.push_back(make_node(begin, end, level, min, ranges));
+    Node& created = nodes.back();
+    if (created.children[0] == -2)
+    {
+        created.children[0] = -1;
+    }
+    else
+    {
+        float const child_size = created.size / 2.f;
+        for (int c = 0; c < 4; ++c)
+        {
+            int32_t child = -1;
+            if (ranges[c] < ranges[c + 1])
+                child = build_subtree(ranges[c], ranges[c + 1], level + 1, min + child_size * glm::vec2{c & 1, c >> 1}, nodes);
+            nodes[static_cast<size_t>(index)].children[c] = child; // nodes a pu être réalloué
+        }
+    }
+    compute_mass(nodes[static_cast<size_t>(index)], nodes);
+    return index;
+}
+
+glm::vec2 BarnesHutTree::acceleration(glm::vec2 position, size_t exclude) const
+{
+    glm::vec2 total{0.f};
+    if (_nodes.empty())
+        return total;
+
+    float const epsilon_squared = softening * softening;
+    float const theta_squared   = theta * theta;
+
+    // Profondeur max 16, au plus 3 frères en attente par niveau
+    std::array<int32_t, 64> stack;
+    size_t                  stack_size = 0;
+    stack[stack_size++]                = 0;
+    while (stack_size > 0)
+    {
+        Node const&     node     = _nodes[static_cast<size_t>(stack[--stack_size])];
+        glm::vec2 const offset   = node.center_of_mass - position;
+        float const     distance = glm::dot(offset, offset);
+
+        bool const leaf = node.children[0] < 0 && node.children[1] < 0 && node.children[2] < 0 && node.children[3] < 0;
+        if (leaf)
+        {
+            for (uint32_t k = node.begin; k < node.end; ++k)
+            {
+                if (_order[k] == exclude)
+                    continue;
+                glm::vec2 const to_particle = glm::vec2{_sorted_x[k], _sorted_y[k]} - position;
+                float const     r2          = glm::dot(to_particle, to_particle) + epsilon_squared;
+                total += to_particle / (r2 * std::sqrt(r2));
+            }
+            continue;
+        }
+
+        // Une cellule qui contient la position est toujours ouverte (sinon la particule s'attirerait elle-même)
+        bool const contains = position.x >= node.min.x && position.y >= node.min.y
+                              && position.x < node.min.x + node.size && position.y < node.min.y + node.size;
+        if (!contains && node.size * node.size < theta_squared * distance)
+        {
+            float const r2 = distance + epsilon_squared;
+            total += node.mass * offset / (r2 * std::sqrt(r2));
+            continue;
+        }
+
+        for (int32_t child : node.children)
+        {
+            if (child >= 0)
+                stack[stack_size++] = child;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Arbre de Barnes–Hut : forces en 1/d² entre toutes les particules (gravitation, ou répulsion électrostatique
+// en changeant le signe de l'intensité) en O(N log N) au lieu de O(N²).
+// build() trie les particules selon leur code de Morton (tri par base parallèle), ce qui range chaque cellule
+// du quadtree dans un intervalle contigu ; les sous-arbres du haut de l'arbre sont construits en parallèle.
+// acceleration() parcourt l'arbre pour une particule : une cellule assez petite vue de loin est remplacée
+// par son centre de masse. Toutes les particules ont la même masse (1).
+class BarnesHutTree {
+public:
+    // Angle d'ouverture : une cellule de côté s à la distance d est approchée si s < theta · d (0 : somme exacte)
+    float theta = 0.5f;
+    // La force devient d / (d² + ε²)^(3/2) : bornée quand deux particules se croisent
+    float softening = 0.01f;
+
+    void build(std::span<float const> x, std::span<float const> y);
+
+    // Somme sur toutes les particules j sauf exclude de (p_j - position) / (|p_j - position|² + ε²)^(3/2),
+    // à multiplier par l'intensité de la force. Lecture seule : peut être appelé depuis plusieurs threads.
+    glm::vec2 acceleration(glm::vec2 position, size_t exclude) const;
+
+    size_t nodes_count() const { return _nodes.size(); }
+
+private:
+    struct Node {
+        glm::vec2 min;            // Coin inférieur gauche de la cellule
+        float     size;           // Côté de la cellule
+        float     mass;           // Nombre de particules dans la cellule
+        glm::vec2 center_of_mass;
+        uint32_t  begin;          // Particules de la cellule : indices [begin, end) dans l'ordre de Morton
+        uint32_t  end;
+        int32_t   children[4];    // -1 : pas d'enfant. Une feuille n'a aucun enfant.
+    };
+
+    // Sous-arbre de la cellule [begin, end) au niveau level, ajouté à nodes (indices relatifs à nodes) ; renvoie sa racine
+    int32_t build_subtree(uint32_t begin, uint32_t end, int level, glm::vec2 min, std::vector<Node>& nodes) const;
+    // Crée le nœud sans ses enfants ; les quatre intervalles des enfants sont écrits dans children_ranges
+    Node make_node(uint32_t begin, uint32_t end, int level, glm::vec2 min, uint32_t (&children_ranges)[5]) const;
+    // Masse et centre de masse, à partir des enfants (déjà complets) ou des particules pour une feuille
+    void compute_mass(Node& node, std::vector<Node> const& nodes) const;
+    void sort_by_morton_code(size_t count);
+
+private:
+    float _root_size{0.f};
+
+    std::vector<Node>     _nodes{};
+    std::vector<uint32_t> _codes{};    // Codes de Morton triés
+    std::vector<uint32_t> _order{};    // _order[k] : indice d'origine de la k-ième particule dans l'ordre de Morton
+    std::vector<float>    _sorted_x{}; // Positions dans l'ordre de Morton (les feuilles sont contiguës en mémoire)
+    std::vector<float>    _sorted_y{};
+
+    // Mémoire de travail du tri, gardée d'un pas à l'autre
+    std::vector<uint32_t> _codes_scratch{};
+    std::vector<uint32_t> _order_scratch{};
+    std::vector<uint32_t> _histograms{};
+};
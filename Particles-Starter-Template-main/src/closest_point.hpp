@@ -0,0 +1,185 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <span>
+#include "glm/glm.hpp"
+
+// Point d'une courbe paramétrique avec ses dérivées analytiques en t
+struct CurveDerivatives {
+    glm::vec2 position;
+    glm::vec2 first;  // C'(t)
+    glm::vec2 second; // C''(t)
+};
+
+struct ClosestPoint {
+    float t;
+    float distance;
+    int   evaluations; // Nombre d'appels à evaluate(), pour mesurer le coût d'une requête
+};
+
+struct RefinedClosestPoint {
+    ClosestPoint point;
+    bool         converged; // false si max_iterations a été atteint
+};
+
+// Méthode de Newton sur f(t) = ||C(t) - p||² / 2 à partir de t0, avec les dérivées analytiques de
+// evaluate(t) -> CurveDerivatives, en restant dans [lo, hi] (sécante entre les bornes ou bissection si le
+// pas de Newton en sort). Pour une courbe fermée, t est pris modulo 1.
+template<typename Evaluate>
+RefinedClosestPoint refine_closest_point(glm::vec2 point, Evaluate const& evaluate, float t0, float lo, float hi, bool closed, float tolerance, int max_iterations)
+{
+    if (!closed)
+    {
+        lo = std::max(lo, 0.f);
+        hi = std::min(hi, 1.f);
+    }
+    float g_lo = NAN; // f' aux bornes, quand on l'a évaluée
+    float g_hi = NAN;
+    float t    = t0;
+
+    RefinedClosestPoint res{.point = {.t = t0, .distance = INFINITY, .evaluations = 0}, .converged = false};
+    while (res.point.evaluations < max_iterations)
+    {
+        CurveDerivatives const c = evaluate(closed ? t - std::floor(t) : t);
+        ++res.point.evaluations;
+
+        glm::vec2 const diff     = c.position - point;
+        float const     g        = glm::dot(diff, c.first);                                // f'(t)
+        float const     h        = glm::dot(c.first, c.first) + glm::dot(diff, c.second); // f''(t)
+        float const     distance = glm::length(diff);
+        if (distance < res.point.distance)
+        {
+            res.point.t        = t;
+            res.point.distance = distance;
+        }
+
+        // Minimum sur une extrémité d'une courbe ouverte
+        if (!closed && ((t <= 0.f && g >= 0.f) || (t >= 1.f && g <= 0.f)))
+        {
+            res.converged = true;
+            break;
+        }
+
+        // Le minimum est du côté où f décroît
+        if (g > 0.f)
+        {
+            hi   = t;
+            g_hi = g;
+        }
+        else
+        {
+            lo   = t;
+            g_lo = g;
+        }
+
+        float next = h > 0.f ? t - g / h : NAN;
+        if (!(next > lo && next < hi)) // Newton sort de l'intervalle (ou f'' <= 0) : sécante entre les bornes, ou bissection
+        {
+            next = !std::isnan(g_lo) && !std::isnan(g_hi)
+                       ? lo - g_lo * (hi - lo) / (g_hi - g_lo)
+                       : (lo + hi) * 0.5f;
+            if (!(next > lo && next < hi))
+                next = (lo + hi) * 0.5f;
+        }
+        if (std::abs(next - t) < tolerance || hi - lo < tolerance)
+        {
+            res.converged = true;
+            break;
+        }
+        t = next;
+    }
+    if (closed)
+        res.point.t -= std::floor(res.point.t);
+    return res;
+}
+
+// Point le plus proche de point sur une courbe C(t), t ∈ [0, 1].
+//  - samples contient des positions de la courbe régulièrement espacées en t, calculées une fois pour
+//    toutes : C(i / (n - 1)) pour une courbe ouverte, C(i / n) pour une courbe fermée (t pris modulo 1).
+//    Le parcours de ces échantillons ne coûte aucune évaluation de la courbe et donne le bon minimum
+//    global ; si d'autres minima locaux sont trop proches pour trancher, on les affine aussi.
+//  - Chaque minimum est ensuite affiné par refine_closest_point() dans l'intervalle entre les
+//    échantillons voisins. Une requête coûte typiquement 3 à 5 évaluations.
+template<typename Evaluate>
+ClosestPoint find_closest_point(glm::vec2 point, Evaluate const& evaluate, std::span<glm::vec2 const> samples, bool closed, float tolerance = 1e-6f, int max_iterations = 8)
+{
+    static constexpr int max_samples = 256;
+    int const            n           = static_cast<int>(samples.size());
+    assert(n >= 2 && n <= max_samples);
+    float const spacing = closed ? 1.f / static_cast<float>(n) : 1.f / static_cast<float>(n - 1);
+
+    auto neighbour = [&](int i, int offset) {
+        int j = i + offset;
+        if (closed)
+            return (j + n) % n;
+        return glm::clamp(j, 0, n - 1);
+    };
+
+    // Parcours des échantillons
+    float distance2[max_samples];
+    int   best = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        glm::vec2 delta = samples[i] - point;
+        distance2[i]    = glm::dot(delta, delta);
+        if (distance2[i] < distance2[best])
+            best = i;
+    }
+
+    int  evaluations = 0;
+    auto refine      = [&](int i) {
+        // Départ au sommet de la parabole qui passe par les distances² des trois échantillons : près d'une pointe,
+        // où C'(t) s'annule, partir de l'échantillon lui-même ne dirait pas de quel côté chercher
+        float const before = distance2[neighbour(i, -1)];
+        float const after  = distance2[neighbour(i, 1)];
+        float const curve  = before - 2.f * distance2[i] + after;
+        float const offset = (closed || (i > 0 && i < n - 1)) && curve > 0.f ? std::clamp(0.5f * (before - after) / curve, -0.5f, 0.5f) : 0.f;
+        float const        t       = static_cast<float>(i) * spacing;
+        ClosestPoint const refined = refine_closest_point(point, evaluate, t + offset * spacing, t - spacing, t + spacing, closed, tolerance, max_iterations).point;
+        evaluations += refined.evaluations;
+        return refined;
+    };
+
+    ClosestPoint res = refine(best);
+
+    // Un autre minimum local des échantillons qui n'est pas plus loin que le meilleur d'un écart entre
+    // deux échantillons peut cacher un point plus proche : on l'affine aussi
+    for (int i = 0; i < n; ++i)
+    {
+        bool const is_local_minimum = distance2[i] <= distance2[neighbour(i, -1)] && distance2[i] <= distance2[neighbour(i, 1)];
+        bool const is_near_best     = i == best || neighbour(i, -1) == best || neighbour(i, 1) == best;
+        if (!is_local_minimum || is_near_best)
+            continue;
+
+        float const margin = std::max(glm::length(samples[i] - samples[neighbour(i, -1)]), glm::length(samples[i] - samples[neighbour(i, 1)]));
+        if (std::sqrt(distance2[i]) < res.distance + margin)
+        {
+            ClosestPoint const other = refine(i);
+            if (other.distance < res.distance)
+                res = other;
+        }
+    }
+
+    res.evaluations = evaluations;
+    return res;
+}
+
+// Reprise à partir du t trouvé au pas précédent (warm start) : Newton seul autour de t_guess, sans
+// parcourir les échantillons. Renvoie std::nullopt si la recherche n'a pas convergé en max_iterations ou
+// si elle est sortie de [t_guess - spacing, t_guess + spacing] : le point a trop bougé, il faut refaire
+// une recherche complète avec find_closest_point().
+template<typename Evaluate>
+std::optional<ClosestPoint> find_closest_point_near(glm::vec2 point, Evaluate const& evaluate, float t_guess, float spacing, bool closed, float tolerance = 1e-6f, int max_iterations = 3)
+{
+    RefinedClosestPoint const res = refine_closest_point(point, evaluate, t_guess, t_guess - spacing, t_guess + spacing, closed, tolerance, max_iterations);
+    if (!res.converged)
+        return std::nullopt;
+
+    // Arrêt contre une borne de l'intervalle : le vrai minimum est peut-être au-delà
+    float const distance_to_bound = spacing - std::abs(res.point.t - t_guess - std::round(res.point.t - t_guess));
+    if (distance_to_bound < 2.f * tolerance && (closed || (res.point.t > 0.f && res.point.t < 1.f)))
+        return std::nullopt;
+    return res.point;
+}
@@ -0,0 +1,56 @@
+#include "collisions.hpp"
+#include <algorithm>
+#include <cmath>
+#include "thread_pool.hpp"
+
+static constexpr size_t particles_per_task = 1024;
+
+void ParticleCollisions::resolve(ParticleStore& particles)
+{
+    size_t const count    = particles.size();
+    float const  diameter = 2.f * particles.radius;
+    if (_grid.cell_size() != diameter) // Voisins à moins d'un diamètre : 3 × 3 cases au plus
+        _grid = SpatialGrid{diameter};
+
+    _snapshot_x.assign(particles.position_x.begin(), particles.position_x.begin() + static_cast<std::ptrdiff_t>(count));
+    _snapshot_y.assign(particles.position_y.begin(), particles.position_y.begin() + static_cast<std::ptrdiff_t>(count));
+    _snapshot_vx.assign(particles.velocity_x.begin(), particles.velocity_x.begin() + static_cast<std::ptrdiff_t>(count));
+    _snapshot_vy.assign(particles.velocity_y.begin(), particles.velocity_y.begin() + static_cast<std::ptrdiff_t>(count));
+    _grid.build(_snapshot_x, _snapshot_y);
+
+    thread_pool().parallel_for(count, particles_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            glm::vec2 const position{_snapshot_x[i], _snapshot_y[i]};
+            glm::vec2 const velocity{_snapshot_vx[i], _snapshot_vy[i]};
+
+            glm::vec2 position_correction{0.f};
+            glm::vec2 velocity_change{0.f};
+            _grid.for_each_candidate(position, diameter, [&](size_t j) {
+                if (j == i)
+                    return;
+                glm::vec2 const offset           = position - glm::vec2{_snapshot_x[j], _snapshot_y[j]};
+                float const     distance_squared = glm::dot(offset, offset);
+                if (distance_squared >= diameter * diameter)
+                    return;
+
+                // Deux disques exactement superposés : on les sépare selon x, dans un sens qui dépend de l'ordre des indices
+                float const     distance = std::sqrt(distance_squared);
+                glm::vec2 const normal   = distance > 1e-12f ? offset / distance : glm::vec2{i < j ? -1.f : 1.f, 0.f};
+
+                // Chacun des deux disques recule de la moitié du chevauchement
+                position_correction += 0.5f * (diameter - distance) * normal;
+
+                // Masses égales : chacun reçoit la moitié de l'impulsion, seulement s'ils se rapprochent
+                float const approach_speed = glm::dot(velocity - glm::vec2{_snapshot_vx[j], _snapshot_vy[j]}, normal);
+                if (approach_speed < 0.f)
+                    velocity_change -= 0.5f * (1.f + restitution) * approach_speed * normal;
+            });
+
+            particles.position_x[i] += position_correction.x;
+            particles.position_y[i] += position_correction.y;
+            particles.velocity_x[i] += velocity_change.x;
+            particles.velocity_y[i] += velocity_change.y;
+        }
+    });
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <vector>
+#include "particle_store.hpp"
+#include "spatial_grid.hpp"
+
+// Collisions entre particules : disques de rayon particles.radius et de même masse.
+// Résolution de type Jacobi : chaque particule calcule sa correction à partir de l'état de toutes les autres
+// au début de la résolution (copié dans _snapshot_*), et n'écrit que dans ses propres colonnes.
+// Le résultat ne dépend donc ni de l'ordre de parcours ni du nombre de threads. Quand une particule touche
+// plusieurs voisines en même temps, les corrections s'additionnent : un empilement se stabilise en quelques pas
+// au lieu d'être résolu exactement en un seul.
+class ParticleCollisions {
+public:
+    // restitution = 1 : choc élastique (les vitesses normales sont échangées), 0 : les deux disques repartent ensemble
+    float restitution = 1.f;
+
+    // Reconstruit la grille et sépare les disques qui se chevauchent (positions et vitesses)
+    void resolve(ParticleStore& particles);
+
+    SpatialGrid const& grid() const { return _grid; }
+
+private:
+    SpatialGrid _grid{1.f}; // Taille des cases remise à 2 × rayon à chaque resolve()
+
+    std::vector<float> _snapshot_x{};
+    std::vector<float> _snapshot_y{};
+    std::vector<float> _snapshot_vx{};
+    std::vector<float> _snapshot_vy{};
+};
@@ -0,0 +1,114 @@
+#include "disk_renderer.hpp"
+#include <algorithm>
+#include <cstddef>
+#include "opengl-framework/opengl-framework.hpp"
+
+static auto make_disk_shader() -> gl::Shader
+{
+    return gl::Shader{
+        gl::Shader_Descriptor{
+            .vertex = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+layout(location = 0) in vec2 in_corner;
+layout(location = 1) in vec2 in_position;
+layout(location = 2) in float in_radius;
+layout(location = 3) in vec4 in_color;
+
+uniform float u_inverse_aspect_ratio;
+
+out vec2 v_corner;
+out vec4 v_color;
+
+void main()
+{
+    vec2 position = in_position + in_radius * in_corner;
+    gl_Position = vec4(position * vec2(u_inverse_aspect_ratio, 1.), 0., 1.);
+    v_corner = in_corner;
+    v_color = in_color;
+}
+)GLSL"}),
+            .fragment = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+in vec2 v_corner;
+in vec4 v_color;
+out vec4 out_color;
+
+void main()
+{
+    if (dot(v_corner, v_corner) > 1.)
+        discard;
+    out_color = v_color;
+}
+)GLSL"}),
+        }
+    };
+}
+
+DiskRenderer::DiskRenderer()
+    : _shader{make_disk_shader()}
+{
+    glGenVertexArrays(1, &_vertex_array);
+    glBindVertexArray(_vertex_array);
+
+    // Coins du carré englobant, communs à toutes les instances (dessinés en GL_TRIANGLE_STRIP)
+    float const corners[] = {
+        -1.f, -1.f,
+        +1.f, -1.f,
+        -1.f, +1.f,
+        +1.f, +1.f,
+    };
+    glGenBuffers(1, &_corners_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _corners_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+    // Un jeu d'attributs par disque : le diviseur à 1 fait avancer ces attributs d'une instance à l'autre
+    glGenBuffers(1, &_instances_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _instances_buffer);
+    auto const attribute = [](GLuint index, GLint size, size_t offset) {
+        glEnableVertexAttribArray(index);
+        glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast<void*>(offset)); // NOLINT(*reinterpret-cast, performance-no-int-to-ptr)
+        glVertexAttribDivisor(index, 1);
+    };
+    attribute(1, 2, offsetof(Instance, position));
+    attribute(2, 1, offsetof(Instance, radius));
+    attribute(3, 4, offsetof(Instance, color));
+
+    glBindVertexArray(0);
+}
+
+DiskRenderer::~DiskRenderer()
+{
+    glDeleteBuffers(1, &_instances_buffer);
+    glDeleteBuffers(1, &_corners_buffer);
+    glDeleteVertexArrays(1, &_vertex_array);
+}
+
+void DiskRenderer::flush()
+{
+    if (_instances.empty())
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, _instances_buffer);
+    auto const bytes = static_cast<GLsizeiptr>(_instances.size() * sizeof(Instance));
+    if (_instances.size() > _instances_buffer_capacity)
+    {
+        // On agrandit par doublement pour ne pas réallouer à chaque frame quand le nombre de particules augmente
+        _instances_buffer_capacity = std::max(_instances.size(), 2 * _instances_buffer_capacity);
+    }
+    // Réallouer le buffer sans données (orphaning) évite d'attendre que le GPU ait fini de dessiner la frame précédente.
+    // Le buffer peut être plus grand que _instances : seules les instances présentes sont copiées.
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(_instances_buffer_capacity * sizeof(Instance)), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, _instances.data());
+
+    _shader.bind();
+    _shader.set_uniform("u_inverse_aspect_ratio", 1.f / gl::framebuffer_aspect_ratio());
+    glBindVertexArray(_vertex_array);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(_instances.size()));
+    glBindVertexArray(0);
+
+    _instances.clear();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include "opengl-framework/opengl-framework.hpp"
+
+// Dessine beaucoup de disques en un seul appel instancié, au lieu d'un draw call (et de cinq uniforms) par disque
+// comme utils::draw_disk(). On soumet les disques pendant la frame avec submit(), puis flush() les envoie au GPU
+// et les dessine. Doit être construit après gl::init() (il crée des objets OpenGL).
+class DiskRenderer {
+public:
+    DiskRenderer();
+    ~DiskRenderer();
+    DiskRenderer(DiskRenderer const&)            = delete;
+    DiskRenderer& operator=(DiskRenderer const&) = delete;
+
+    void reserve(size_t count) { _instances.reserve(count); }
+
+    void submit(glm::vec2 position, float radius, glm::vec4 const& color)
+    {
+        _instances.push_back({position, radius, color});
+    }
+
+    // Dessine tous les disques soumis depuis le dernier flush(), puis vide la liste
+    void flush();
+
+    size_t pending() const { return _instances.size(); }
+
+private:
+    // Un disque dans le buffer d'instances (attributs 1 à 3 du vertex shader)
+    struct Instance {
+        glm::vec2 position;
+        float     radius;
+        glm::vec4 color;
+    };
+
+private:
+    std::vector<Instance> _instances{};
+
+    gl::Shader _shader;
+    GLuint     _vertex_array{};
+    GLuint     _corners_buffer{};
+    GLuint     _instances_buffer{};
+    size_t     _instances_buffer_capacity{0}; // En nombre d'instances
+};
@@ -0,0 +1,128 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "barnes_hut.hpp"
+#include "glm/glm.hpp"
+#include "particle_store.hpp"
+
+// Bibliothèque de champs de force, assemblés à la compilation dans un ForcePipeline.
+// Chaque force est un objet appelable force(particles, i) -> accélération de la particule i, qui ne fait que lire
+// les particules (un cache à mettre à jour se remplit avant le pipeline, cf. Simulation::update_heart_distances()).
+// Le pipeline additionne toutes ses forces dans une seule boucle sur les particules et écrit une seule fois
+// les colonnes acceleration_x / acceleration_y : ajouter une force n'ajoute pas de passe sur la mémoire, et comme
+// les types sont connus à la compilation (pas d'appel virtuel), le compilateur peut tout inliner dans la boucle.
+
+// Accélération constante
+struct Gravity {
+    glm::vec2 acceleration{0.f, -0.4f};
+
+    glm::vec2 operator()(ParticleStore const&, size_t) const { return acceleration; }
+};
+
+// Ce qu'une force de courbe a besoin de savoir sur le point de la courbe le plus proche
+struct CurveDistance {
+    float     distance;
+    glm::vec2 normal;
+};
+
+// Poussée le long de la normale de la courbe la plus proche : strength · exp(-falloff · distance).
+// query(particles, i) -> CurveDistance fournit la distance et la normale (grille précalculée, calcul exact, ...).
+template<typename Query>
+struct CurveRepulsion {
+    Query query;
+    float strength = 5.f;
+    float falloff  = 10.f;
+
+    glm::vec2 operator()(ParticleStore const& particles, size_t i) const
+    {
+        CurveDistance const curve = query(particles, i);
+        return curve.normal * (strength * std::exp(-curve.distance * falloff));
+    }
+};
+
+// Attraction vers un point en 1/d² (répulsion si strength < 0), adoucie par softening près du centre
+struct RadialAttractor {
+    glm::vec2 center{0.f};
+    float     strength  = 1.f;
+    float     softening = 0.05f;
+
+    glm::vec2 operator()(ParticleStore const& particles, size_t i) const
+    {
+        glm::vec2 const offset = center - particles.position(i);
+        float const     r2     = glm::dot(offset, offset) + softening * softening;
+        return offset * (strength / (r2 * std::sqrt(r2)));
+    }
+};
+
+// Rotation autour d'un point (sens trigonométrique si strength > 0), qui décroît en 1/d
+struct Vortex {
+    glm::vec2 center{0.f};
+    float     strength  = 1.f;
+    float     softening = 0.05f;
+
+    glm::vec2 operator()(ParticleStore const& particles, size_t i) const
+    {
+        glm::vec2 const offset = particles.position(i) - center;
+        float const     r2     = glm::dot(offset, offset) + softening * softening;
+        return glm::vec2{-offset.y, offset.x} * (strength / r2);
+    }
+};
+
+// Frottement fluide linéaire : freine proportionnellement à la vitesse
+struct Drag {
+    float coefficient = 0.5f;
+
+    glm::vec2 operator()(ParticleStore const& particles, size_t i) const { return -coefficient * particles.velocity(i); }
+};
+
+// Turbulence sans divergence (rotationnel de ψ = sin(f·x + φ)·sin(f·y + φ)) : les particules tourbillonnent
+// sans s'accumuler. Faire varier phase au cours du temps pour animer le champ.
+struct Turbulence {
+    float amplitude = 0.5f;
+    float frequency = 8.f;
+    float phase     = 0.f;
+
+    glm::vec2 operator()(ParticleStore const& particles, size_t i) const
+    {
+        glm::vec2 const p = particles.position(i) * frequency + phase;
+        return amplitude * glm::vec2{std::sin(p.x) * std::cos(p.y), -std::cos(p.x) * std::sin(p.y)};
+    }
+};
+
+// Attraction en 1/d² entre toutes les particules via un BarnesHutTree déjà construit (répulsion si strength < 0)
+struct ParticleAttraction {
+    BarnesHutTree const* tree     = nullptr;
+    float                strength = 1.f;
+
+    glm::vec2 operator()(ParticleStore const& particles, size_t i) const { return strength * tree->acceleration(particles.position(i), i); }
+};
+
+template<typename... Forces>
+struct ForcePipeline {
+    std::tuple<Forces...> forces;
+
+    // Écrit dans acceleration_x / acceleration_y la somme des forces, pour les particules [begin, end).
+    // Les forces sont additionnées dans l'ordre de la liste.
+    void apply(ParticleStore& particles, size_t begin, size_t end) const
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            glm::vec2 const total       = acceleration(particles, i);
+            particles.acceleration_x[i] = total.x;
+            particles.acceleration_y[i] = total.y;
+        }
+    }
+
+    glm::vec2 acceleration(ParticleStore const& particles, size_t i) const
+    {
+        return std::apply([&](auto const&... force) { return (glm::vec2{0.f} + ... + force(particles, i)); }, forces);
+    }
+};
+
+template<typename... Forces>
+ForcePipeline<Forces...> make_force_pipeline(Forces... forces)
+{
+    return ForcePipeline<Forces...>{{std::move(forces)...}};
+}
@@ -0,0 +1,399 @@
+#include "gpu_simulation.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "simulation.hpp"
+
+// Doit correspondre aux déclarations GLSL ci-dessous (std430)
+struct GpuParticle {
+    glm::vec2 position;
+    glm::vec2 previous_position;
+    glm::vec2 velocity;
+};
+
+struct GpuControl {
+    uint32_t dispatch[3];       // glDispatchComputeIndirect
+    uint32_t source_count;      // Particules vivantes au début du pas
+    uint32_t draw_vertex_count; // glDrawArraysIndirect : 4 coins...
+    uint32_t alive_count;       // ... et autant d'instances que de survivantes (compteur atomique)
+    uint32_t draw_first;
+    uint32_t draw_base_instance;
+    uint32_t spawn_count; // Particules créées pendant ce pas
+};
+static_assert(sizeof(GpuParticle) == 24);
+
+static std::string const shared_declarations = R"GLSL(
+#version 430
+
+struct Particle {
+    vec2 position;
+    vec2 previous_position;
+    vec2 velocity;
+};
+
+layout(std430, binding = 2) buffer Control {
+    uint dispatch_x;
+    uint dispatch_y;
+    uint dispatch_z;
+    uint source_count;
+    uint draw_vertex_count;
+    uint alive_count;
+    uint draw_first;
+    uint draw_base_instance;
+    uint spawn_count;
+};
+)GLSL";
+
+static std::string const prepare_shader = shared_declarations + R"GLSL(
+layout(local_size_x = 1) in;
+
+uniform uint u_capacity;
+uniform uint u_rain_per_step;
+
+void main()
+{
+    source_count = alive_count;
+    alive_count  = 0u;
+    spawn_count  = min(u_rain_per_step, u_capacity - source_count);
+    dispatch_x   = max((source_count + spawn_count + 255u) / 256u, 1u);
+    dispatch_y   = 1u;
+    dispatch_z   = 1u;
+}
+)GLSL";
+
+// Mêmes constantes que Simulation (création en y = 1.1, champ 5·exp(-10·distance), gravité, mort en y < -1.2)
+static std::string const update_shader = shared_declarations + R"GLSL(
+layout(local_size_x = 256) in;
+
+layout(std430, binding = 0) readonly buffer Source {
+    Particle source[];
+};
+layout(std430, binding = 1) writeonly buffer Destination {
+    Particle destination[];
+};
+
+uniform float     u_dt;
+uniform float     u_aspect_ratio;
+uniform uint      u_step_index;
+uniform uint      u_seed;
+uniform sampler2D u_heart_field; // Distance signée, normale x, normale y
+uniform vec2      u_heart_field_scale;
+uniform vec2      u_heart_field_offset;
+
+// Hash PCG : un nombre aléatoire par (graine, pas, création), sans état à conserver entre les threads
+uint hash(uint x)
+{
+    uint state = x * 747796405u + 2891336453u;
+    uint word  = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+float random01(uint a, uint b)
+{
+    return float(hash(a ^ hash(b)) >> 8u) / 16777216.;
+}
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+
+    Particle p;
+    if (i < source_count)
+    {
+        p = source[i];
+    }
+    else if (i < source_count + spawn_count)
+    {
+        float x    = mix(-u_aspect_ratio, u_aspect_ratio, random01(hash(u_seed ^ hash(u_step_index)), i - source_count));
+        p.position = vec2(x, 1.1);
+        p.velocity = vec2(0.);
+    }
+    else
+    {
+        return;
+    }
+    p.previous_position = p.position;
+
+    // Interpolation bilinéaire de la grille par le sampler (les nœuds sont aux centres des texels)
+    vec3  heart    = textureLod(u_heart_field, p.position * u_heart_field_scale + u_heart_field_offset, 0.).xyz;
+    vec2  normal   = heart.yz;
+    float length_n = length(normal);
+    if (length_n > 1e-6)
+        normal /= length_n;
+
+    float strength     = 5. * exp(-abs(heart.x) * 10.);
+    vec2  acceleration = normal * strength + vec2(0., -0.4);
+
+    p.velocity += acceleration * u_dt;
+    p.position += p.velocity * u_dt;
+
+    if (p.position.y < -1.2)
+        return;
+    destination[atomicAdd(alive_count, 1u)] = p;
+}
+)GLSL";
+
+static auto make_draw_shader() -> gl::Shader
+{
+    return gl::Shader{
+        gl::Shader_Descriptor{
+            .vertex = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+layout(location = 0) in vec2 in_corner;
+layout(location = 1) in vec2 in_position;
+layout(location = 2) in vec2 in_previous_position;
+
+uniform float u_alpha;
+uniform float u_radius;
+uniform float u_inverse_aspect_ratio;
+
+out vec2 v_corner;
+
+void main()
+{
+    vec2 position = mix(in_previous_position, in_position, u_alpha) + u_radius * in_corner;
+    gl_Position = vec4(position * vec2(u_inverse_aspect_ratio, 1.), 0., 1.);
+    v_corner = in_corner;
+}
+)GLSL"}),
+            .fragment = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+in vec2 v_corner;
+out vec4 out_color;
+uniform vec4 u_color;
+
+void main()
+{
+    if (dot(v_corner, v_corner) > 1.)
+        discard;
+    out_color = u_color;
+}
+)GLSL"}),
+        }
+    };
+}
+
+// Log de compilation d'un shader ou d'édition des liens d'un programme
+template<typename GetParameter, typename GetLog>
+static std::string info_log(GLuint id, GetParameter get_parameter, GetLog get_log)
+{
+    GLint length = 0;
+    get_parameter(id, GL_INFO_LOG_LENGTH, &length);
+    std::vector<GLchar> log(static_cast<size_t>(std::max(length, 1)));
+    get_log(id, static_cast<GLsizei>(log.size()), nullptr, log.data());
+    return std::string{log.data()};
+}
+
+static GLuint make_compute_program(std::string const& source)
+{
+    GLuint      shader = glCreateShader(GL_COMPUTE_SHADER);
+    char const* code   = source.c_str();
+    glShaderSource(shader, 1, &code, nullptr);
+    glCompileShader(shader);
+
+    GLint success = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (success != GL_TRUE)
+    {
+        std::string const message = "Échec de la compilation d'un compute shader :\n" + info_log(shader, glGetShaderiv, glGetShaderInfoLog);
+        glDeleteShader(shader);
+        std::cerr << message << '\n';
+        throw std::runtime_error{message};
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, shader);
+    glLinkProgram(program);
+    glDeleteShader(shader);
+
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success != GL_TRUE)
+    {
+        std::string const message = "Échec de l'édition des liens d'un compute shader :\n" + info_log(program, glGetProgramiv, glGetProgramInfoLog);
+        glDeleteProgram(program);
+        std::cerr << message << '\n';
+        throw std::runtime_error{message};
+    }
+    return program;
+}
+
+bool GpuSimulation::is_supported()
+{
+    return GLAD_GL_VERSION_4_3 != 0;
+}
+
+GpuSimulation::GpuSimulation(size_t max_particles)
+    : _capacity{max_particles}
+    , _draw_shader{make_draw_shader()}
+{
+    // Le destructeur n'est pas appelé si le constructeur lève : le premier programme est libéré ici
+    _prepare_program = make_compute_program(prepare_shader);
+    try
+    {
+        _update_program = make_compute_program(update_shader);
+    }
+    catch (...)
+    {
+        glDeleteProgram(_prepare_program);
+        throw;
+    }
+
+    // Emplacements des uniforms cherchés une fois pour toutes, pas à chaque pas
+    _uniforms = {
+        .capacity           = glGetUniformLocation(_prepare_program, "u_capacity"),
+        .rain_per_step      = glGetUniformLocation(_prepare_program, "u_rain_per_step"),
+        .dt                 = glGetUniformLocation(_update_program, "u_dt"),
+        .aspect_ratio       = glGetUniformLocation(_update_program, "u_aspect_ratio"),
+        .step_index         = glGetUniformLocation(_update_program, "u_step_index"),
+        .seed               = glGetUniformLocation(_update_program, "u_seed"),
+        .heart_field        = glGetUniformLocation(_update_program, "u_heart_field"),
+        .heart_field_scale  = glGetUniformLocation(_update_program, "u_heart_field_scale"),
+        .heart_field_offset = glGetUniformLocation(_update_program, "u_heart_field_offset"),
+    };
+
+    { // Particules (ping-pong)
+        glGenBuffers(2, _particles);
+        for (GLuint buffer : _particles)
+        {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(_capacity * sizeof(GpuParticle)), nullptr, GL_DYNAMIC_COPY);
+        }
+    }
+
+    { // Compteurs : aucune particule au départ
+        GpuControl const control{
+            .dispatch           = {1, 1, 1},
+            .source_count       = 0,
+            .draw_vertex_count  = 4,
+            .alive_count        = 0,
+            .draw_first         = 0,
+            .draw_base_instance = 0,
+            .spawn_count        = 0,
+        };
+        glGenBuffers(1, &_control_buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _control_buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GpuControl), &control, GL_DYNAMIC_COPY);
+    }
+
+    { // Champ de distance du cœur, le même que sur le CPU
+        HeartDistanceField const heart_field = Simulation::make_heart_field();
+        glm::ivec2 const         size        = heart_field.grid_size();
+
+        std::vector<float> texels{};
+        texels.reserve(heart_field.signed_distances().size() * 3);
+        for (size_t i = 0; i < heart_field.signed_distances().size(); ++i)
+            texels.insert(texels.end(), {heart_field.signed_distances()[i], heart_field.normals_x()[i], heart_field.normals_y()[i]});
+
+        glGenTextures(1, &_heart_field_texture);
+        glBindTexture(GL_TEXTURE_2D, _heart_field_texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, size.x, size.y, 0, GL_RGB, GL_FLOAT, texels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); // En dehors de la grille : valeur du bord
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        // Nœud k en coordonnée de texture (k + 0.5) / size
+        _heart_field_scale  = 1.f / (heart_field.cell_size() * glm::vec2{size});
+        _heart_field_offset = (0.5f - heart_field.min() / heart_field.cell_size()) / glm::vec2{size};
+    }
+
+    { // Dessin : coins communs + position et position précédente lues directement dans le buffer des particules
+        float const corners[] = {
+            -1.f, -1.f,
+            +1.f, -1.f,
+            -1.f, +1.f,
+            +1.f, +1.f,
+        };
+        glGenBuffers(1, &_corners_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, _corners_buffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+        glGenVertexArrays(2, _vertex_arrays);
+        for (int i = 0; i < 2; ++i)
+        {
+            glBindVertexArray(_vertex_arrays[i]);
+            glBindBuffer(GL_ARRAY_BUFFER, _corners_buffer);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+
+            glBindBuffer(GL_ARRAY_BUFFER, _particles[i]);
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GpuParticle), reinterpret_cast<void*>(offsetof(GpuParticle, position))); // NOLINT(*reinterpret-cast, performance-no-int-to-ptr)
+            glVertexAttribDivisor(1, 1);
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(GpuParticle), reinterpret_cast<void*>(offsetof(GpuParticle, previous_position))); // NOLINT(*reinterpret-cast, performance-no-int-to-ptr)
+            glVertexAttribDivisor(2, 1);
+        }
+        glBindVertexArray(0);
+    }
+}
+
+GpuSimulation::~GpuSimulation()
+{
+    glDeleteVertexArrays(2, _vertex_arrays);
+    glDeleteBuffers(1, &_corners_buffer);
+    glDeleteTextures(1, &_heart_field_texture);
+    glDeleteBuffers(1, &_control_buffer);
+    glDeleteBuffers(2, _particles);
+    glDeleteProgram(_update_program);
+    glDeleteProgram(_prepare_program);
+}
+
+void GpuSimulation::step(float dt, float aspect_ratio)
+{
+    int const next = 1 - _current;
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _particles[_current]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, _particles[next]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, _control_buffer);
+
+    glUseProgram(_prepare_program);
+    glUniform1ui(_uniforms.capacity, static_cast<GLuint>(_capacity));
+    glUniform1ui(_uniforms.rain_per_step, static_cast<GLuint>(std::max(rain_per_step, 0)));
+    glDispatchCompute(1, 1, 1);
+    // Les arguments du dispatch suivant sont écrits par le shader
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    glUseProgram(_update_program);
+    glUniform1f(_uniforms.dt, dt);
+    glUniform1f(_uniforms.aspect_ratio, aspect_ratio);
+    glUniform1ui(_uniforms.step_index, _step_index++);
+    glUniform1ui(_uniforms.seed, seed);
+    glUniform1i(_uniforms.heart_field, 0);
+    glUniform2f(_uniforms.heart_field_scale, _heart_field_scale.x, _heart_field_scale.y);
+    glUniform2f(_uniforms.heart_field_offset, _heart_field_offset.x, _heart_field_offset.y);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _heart_field_texture);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, _control_buffer);
+    glDispatchComputeIndirect(offsetof(GpuControl, dispatch));
+    // Le pas suivant relit les particules et le compteur, le dessin s'en sert comme attributs et commande indirecte
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    _current = next;
+}
+
+void GpuSimulation::draw(float alpha, float radius, glm::vec4 const& color)
+{
+    _draw_shader.bind();
+    _draw_shader.set_uniform("u_alpha", alpha);
+    _draw_shader.set_uniform("u_radius", radius);
+    _draw_shader.set_uniform("u_inverse_aspect_ratio", 1.f / gl::framebuffer_aspect_ratio());
+    _draw_shader.set_uniform("u_color", color);
+
+    glBindVertexArray(_vertex_arrays[_current]);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _control_buffer);
+    glDrawArraysIndirect(GL_TRIANGLE_STRIP, reinterpret_cast<void*>(offsetof(GpuControl, draw_vertex_count))); // NOLINT(*reinterpret-cast, performance-no-int-to-ptr)
+    glBindVertexArray(0);
+}
+
+size_t GpuSimulation::read_size() const
+{
+    uint32_t alive_count = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _control_buffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, offsetof(GpuControl, alive_count), sizeof(alive_count), &alive_count);
+    return alive_count;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "opengl-framework/opengl-framework.hpp"
+
+// Backend GPU de la pluie de particules (--gpu) : mêmes règles que Simulation, mais l'état des particules reste
+// sur le GPU, dans deux shader storage buffers utilisés à tour de rôle (ping-pong).
+// Chaque pas est fait de deux dispatchs de compute shaders, sans aucune lecture côté CPU :
+//  - "prepare" (un seul thread) lit le nombre de particules vivantes, calcule le nombre de créations
+//    et écrit la taille du dispatch suivant ;
+//  - "update" (indirect) crée les nouvelles gouttes, applique champ du cœur + gravité, intègre,
+//    et recopie les survivantes de façon compacte dans l'autre buffer grâce à un compteur atomique.
+// Ce compteur est directement le nombre d'instances de la commande de dessin indirecte : draw() lit le buffer
+// des particules comme attributs d'instance, sans copie.
+// L'ordre des particules dans le buffer dépend de l'ordre des atomiques : contrairement au CPU, le résultat
+// n'est pas reproductible bit à bit d'une exécution à l'autre.
+// Nécessite OpenGL 4.3 (cf. is_supported()) et doit être construit après gl::init(). Le constructeur lève
+// std::runtime_error si le pilote refuse un compute shader (compilation ou édition des liens).
+// Pas de test automatique : les tests (tests/) tournent sans contexte OpenGL.
+class GpuSimulation {
+public:
+    // Compute shaders, SSBO et dispatch indirect
+    static bool is_supported();
+
+    explicit GpuSimulation(size_t max_particles);
+    ~GpuSimulation();
+    GpuSimulation(GpuSimulation const&)            = delete;
+    GpuSimulation& operator=(GpuSimulation const&) = delete;
+
+    // Particules créées en haut de l'écran à chaque pas (dans la limite de la capacité)
+    int rain_per_step = 5;
+    // Graine des créations : avec la même graine, les mêmes particules tombent aux mêmes pas
+    uint32_t seed = 0;
+
+    void step(float dt, float aspect_ratio);
+    // Disques entre la position du pas précédent et la position actuelle, comme ParticleStore::interpolated_position()
+    void draw(float alpha, float radius, glm::vec4 const& color);
+
+    size_t capacity() const { return _capacity; }
+    // Relit le compteur sur le CPU : attend la fin des calculs en cours, à ne pas appeler à chaque frame
+    size_t read_size() const;
+
+private:
+    size_t   _capacity;
+    uint32_t _step_index{0}; // Compteur du générateur aléatoire des créations
+    int      _current{0};    // Buffer qui contient l'état actuel
+
+    GLuint _particles[2]{};
+    GLuint _vertex_arrays[2]{}; // Un par buffer de particules, pour les dessiner comme attributs d'instance
+    GLuint _corners_buffer{};
+    GLuint _control_buffer{};   // Compteurs + arguments du dispatch et du dessin indirects
+    GLuint _heart_field_texture{};
+    GLuint _prepare_program{};
+    GLuint _update_program{};
+
+    // Emplacements des uniforms des deux compute shaders
+    struct UniformLocations {
+        GLint capacity{-1};
+        GLint rain_per_step{-1};
+        GLint dt{-1};
+        GLint aspect_ratio{-1};
+        GLint step_index{-1};
+        GLint seed{-1};
+        GLint heart_field{-1};
+        GLint heart_field_scale{-1};
+        GLint heart_field_offset{-1};
+    };
+    UniformLocations _uniforms{};
+
+    glm::vec2  _heart_field_scale{};  // position * scale + offset = coordonnées de texture dans la grille du cœur
+    glm::vec2  _heart_field_offset{};
+    gl::Shader _draw_shader;
+};
@@ -0,0 +1,63 @@
+#include "headless.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "simulation.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+
+static bool dump_particles(ParticleStore const& particles, std::filesystem::path const& path)
+{
+    auto file = std::ofstream{path};
+    if (!file)
+        return false;
+
+    file << "x,y,vx,vy\n";
+    for (size_t i = 0; i < particles.size(); ++i)
+        file << particles.position_x[i] << ',' << particles.position_y[i] << ',' << particles.velocity_x[i] << ',' << particles.velocity_y[i] << '\n';
+    return true;
+}
+
+int run_headless(HeadlessOptions const& options)
+{
+    Simulation simulation{options.max_particles};
+    simulation.use_distance_field     = options.use_distance_field;
+    simulation.rain_per_step          = options.rain_per_step;
+    simulation.collide_particles      = options.collide_particles;
+    simulation.particle_attraction    = options.particle_attraction;
+    simulation.attraction_tree.theta  = options.theta;
+    simulation.collide_with_heart     = options.collide_with_heart;
+    simulation.heart_emitter_per_step = options.heart_emitter_per_step;
+    simulation.set_rain_pattern(options.rain_pattern);
+    simulation.prepare();
+
+    double particle_steps = 0.; // Somme sur tous les pas du nombre de particules simulées
+
+    auto const start = std::chrono::steady_clock::now();
+    for (int step = 0; step < options.steps; ++step)
+    {
+        simulation.step(options.dt, options.aspect_ratio);
+        particle_steps += static_cast<double>(simulation.particles.size());
+    }
+    auto const   end     = std::chrono::steady_clock::now();
+    double const seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << options.steps << " pas de " << options.dt << " s en " << seconds << " s ("
+              << thread_pool().threads_count() << " threads, " << simd::instruction_set() << ")\n";
+    std::cout << "Graine : " << utils::random_seed() << " (--seed pour rejouer)\n";
+    std::cout << "Débit : " << (seconds > 0. ? particle_steps / seconds : 0.) << " particules·pas/s\n";
+    std::cout << "Particules : " << simulation.particles.size() << " à la fin, max " << simulation.particles.high_water_mark()
+              << " / " << simulation.particles.capacity() << '\n';
+
+    if (options.dump_path)
+    {
+        if (!dump_particles(simulation.particles, *options.dump_path))
+        {
+            std::cerr << "Impossible d'écrire " << options.dump_path->string() << '\n';
+            return 1;
+        }
+        std::cout << "État final écrit dans " << options.dump_path->string() << '\n';
+    }
+    return 0;
+}
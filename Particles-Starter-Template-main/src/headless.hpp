@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include "point_sequences.hpp"
+
+// Paramètres du mode sans fenêtre (--headless), pour les benchmarks et les calculs en batch
+struct HeadlessOptions {
+    int                                  steps               = 1000;
+    float                                dt                  = 1.f / 120.f;
+    float                                aspect_ratio        = 16.f / 9.f; // Pas de framebuffer : largeur de la zone de pluie
+    std::optional<std::filesystem::path> dump_path{};                      // Si présent, état final écrit en CSV
+    bool                                 use_distance_field  = true;       // cf. Simulation::use_distance_field
+    size_t                               max_particles       = 100'000;
+    int                                  rain_per_step       = 5;
+    bool                                 collide_particles   = false;
+    float                                particle_attraction = 0.f;
+    float                                theta               = 0.5f;       // Angle d'ouverture de Barnes–Hut
+    bool                                 collide_with_heart  = false;      // cf. Simulation::collide_with_heart
+    PointPattern                         rain_pattern        = PointPattern::Uniform; // cf. Simulation::set_rain_pattern()
+    // Émetteur qui fait le tour du cœur (cf. Simulation::heart_emitter_per_step) ; 0 : désactivé
+    int                                  heart_emitter_per_step = 0;
+};
+
+// Fait tourner la simulation sans créer de fenêtre ni de contexte OpenGL, et affiche le débit
+int run_headless(HeadlessOptions const& options);
@@ -0,0 +1,76 @@
+#include "heart.hpp"
+#include <glm/gtc/constants.hpp>
+#include <array>
+#include <cmath>
+
+// Courbe de cœur : t ∈ [0, 1]
+glm::vec2 heart_curve(float t) {
+    float angle = t * glm::two_pi<float>(); // t ∈ [0, 1] → angle ∈ [0, 2π]
+    float x = 16.f * std::pow(std::sin(angle), 3.f);
+    float y = 13.f * std::cos(angle) - 5.f * std::cos(2.f * angle) - 2.f * std::cos(3.f * angle) - std::cos(4.f * angle);
+    return glm::vec2(x, y) / 18.f; // Normalisation dans [-1,1]
+}
+
+CurveDerivatives heart_curve_derivatives(float t) {
+    float angle = t * glm::two_pi<float>();
+
+    // Un seul sin / cos, les multiples de l'angle s'en déduisent
+    float s1 = std::sin(angle);
+    float c1 = std::cos(angle);
+    float s2 = 2.f * s1 * c1;
+    float c2 = 2.f * c1 * c1 - 1.f;
+    float s3 = s2 * c1 + c2 * s1;
+    float c3 = c2 * c1 - s2 * s1;
+    float s4 = 2.f * s2 * c2;
+    float c4 = 2.f * c2 * c2 - 1.f;
+
+    // Dérivées par rapport à l'angle
+    glm::vec2 position{16.f * s1 * s1 * s1, 13.f * c1 - 5.f * c2 - 2.f * c3 - c4};
+    glm::vec2 first{48.f * s1 * s1 * c1, -13.f * s1 + 10.f * s2 + 6.f * s3 + 4.f * s4};
+    glm::vec2 second{48.f * (2.f * s1 * c1 * c1 - s1 * s1 * s1), -13.f * c1 + 20.f * c2 + 18.f * c3 + 16.f * c4};
+
+    // d/dt = 2π d/dangle
+    float k = glm::two_pi<float>();
+    return CurveDerivatives{
+        .position = position / 18.f,
+        .first = first * (k / 18.f),
+        .second = second * (k * k / 18.f),
+    };
+}
+
+glm::vec2 heart_tangent(float t, float epsilon) {
+    CurveDerivatives c = heart_curve_derivatives(t);
+    if (glm::dot(c.first, c.first) < 1e-8f) {
+        // Dérivée numérique centrée (t modulo 1, la courbe est fermée) : aux pointes, elle suit la bissectrice
+        // des deux branches
+        glm::vec2 p1 = heart_curve(glm::fract(t - epsilon));
+        glm::vec2 p2 = heart_curve(glm::fract(t + epsilon));
+        return glm::normalize(p2 - p1);
+    }
+    return glm::normalize(c.first);
+}
+
+// Positions régulièrement espacées en t, pour initialiser la recherche du point le plus proche
+static constexpr int heart_samples_count = 64;
+
+static std::array<glm::vec2, heart_samples_count> const& heart_samples() {
+    static std::array<glm::vec2, heart_samples_count> const samples = []() {
+        std::array<glm::vec2, heart_samples_count> res{};
+        for (int i = 0; i < heart_samples_count; ++i)
+            res[i] = heart_curve(static_cast<float>(i) / heart_samples_count);
+        return res;
+    }();
+    return samples;
+}
+
+ClosestPoint closest_point_on_heart(glm::vec2 point) {
+    return find_closest_point(point, &heart_curve_derivatives, heart_samples(), true);
+}
+
+std::optional<ClosestPoint> closest_point_on_heart_near(glm::vec2 point, float t_guess) {
+    return find_closest_point_near(point, &heart_curve_derivatives, t_guess, 1.f / heart_samples_count, true);
+}
+
+float find_closest_t_on_heart(glm::vec2 point) {
+    return closest_point_on_heart(point).t;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "closest_point.hpp"
+#include <optional>
+#include "glm/glm.hpp"
+
+// Courbe de cœur : t ∈ [0, 1]
+glm::vec2 heart_curve(float t);
+
+// Position, dérivée première et dérivée seconde analytiques de heart_curve()
+CurveDerivatives heart_curve_derivatives(float t);
+
+// Tangente unitaire (analytique). Aux deux pointes du cœur, où la dérivée s'annule, on revient à la
+// dérivée numérique centrée sur [t - epsilon, t + epsilon].
+glm::vec2 heart_tangent(float t, float epsilon = 0.001f);
+
+// Point du cœur le plus proche d'un point donné (cf. find_closest_point())
+ClosestPoint closest_point_on_heart(glm::vec2 point);
+// Reprise à partir du t trouvé au pas précédent (cf. find_closest_point_near()) : std::nullopt si le point
+// a trop bougé et qu'il faut refaire une recherche complète avec closest_point_on_heart()
+std::optional<ClosestPoint> closest_point_on_heart_near(glm::vec2 point, float t_guess);
+// t du point du cœur le plus proche d'un point donné
+float find_closest_t_on_heart(glm::vec2 point);
@@ -0,0 +1,105 @@
+#include "heart_field.hpp"
+#include <cmath>
+#include <vector>
+#include "heart.hpp"
+#include "thread_pool.hpp"
+
+// Polygone approchant le cœur, pour savoir si un point est à l'intérieur
+static constexpr int heart_polygon_size = 1024;
+
+static std::vector<glm::vec2> const& heart_polygon()
+{
+    static std::vector<glm::vec2> const samples = []() {
+        std::vector<glm::vec2> res(heart_polygon_size);
+        for (int i = 0; i < heart_polygon_size; ++i)
+            res[i] = heart_curve(static_cast<float>(i) / heart_polygon_size);
+        return res;
+    }();
+    return samples;
+}
+
+// Test pair-impair sur le polygone
+static bool is_inside_heart(glm::vec2 position)
+{
+    auto const& polygon = heart_polygon();
+    bool        inside  = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+    {
+        glm::vec2 a = polygon[i];
+        glm::vec2 b = polygon[j];
+        if ((a.y > position.y) != (b.y > position.y)
+            && position.x < (b.x - a.x) * (position.y - a.y) / (b.y - a.y) + a.x)
+            inside = !inside;
+    }
+    return inside;
+}
+
+HeartFieldSample HeartDistanceField::compute(glm::vec2 position)
+{
+    ClosestPoint const closest = closest_point_on_heart(position);
+    glm::vec2 const    tangent = heart_tangent(closest.t);
+    return HeartFieldSample{
+        .signed_distance = is_inside_heart(position) ? -closest.distance : closest.distance,
+        .t               = closest.t,
+        .normal          = glm::vec2(-tangent.y, tangent.x),
+    };
+}
+
+HeartDistanceField::HeartDistanceField(glm::vec2 min, glm::vec2 max, float cell_size)
+    : _min{min}
+    , _max{max}
+    , _size{glm::ivec2{glm::ceil((max - min) / cell_size)} + 1}
+    , _cell_size{(max - min) / glm::vec2{_size - 1}}
+{
+    size_t const nodes_count = static_cast<size_t>(_size.x) * static_cast<size_t>(_size.y);
+    _signed_distance.resize(nodes_count);
+    _t.resize(nodes_count);
+    _normal_x.resize(nodes_count);
+    _normal_y.resize(nodes_count);
+
+    heart_polygon(); // Initialisé avant de lancer les threads
+    thread_pool().parallel_for(static_cast<size_t>(_size.y), 4, [&](size_t begin, size_t end) {
+        for (int y = static_cast<int>(begin); y < static_cast<int>(end); ++y)
+        {
+            for (int x = 0; x < _size.x; ++x)
+            {
+                HeartFieldSample const node = compute(_min + glm::vec2{x, y} * _cell_size);
+                size_t const           i    = index(x, y);
+                _signed_distance[i] = node.signed_distance;
+                _t[i]               = node.t;
+                _normal_x[i]        = node.normal.x;
+                _normal_y[i]        = node.normal.y;
+            }
+        }
+    });
+}
+
+HeartFieldSample HeartDistanceField::sample(glm::vec2 position) const
+{
+    glm::vec2 const grid_position = (position - _min) / _cell_size;
+    glm::ivec2 const cell         = glm::clamp(glm::ivec2{glm::floor(grid_position)}, glm::ivec2{0}, _size - 2);
+    glm::vec2 const f             = grid_position - glm::vec2{cell};
+
+    size_t const i00 = index(cell.x, cell.y);
+    size_t const i10 = index(cell.x + 1, cell.y);
+    size_t const i01 = index(cell.x, cell.y + 1);
+    size_t const i11 = index(cell.x + 1, cell.y + 1);
+
+    auto bilinear = [&](std::vector<float> const& values) {
+        float bottom = glm::mix(values[i00], values[i10], f.x);
+        float top    = glm::mix(values[i01], values[i11], f.x);
+        return glm::mix(bottom, top, f.y);
+    };
+
+    glm::vec2 normal{bilinear(_normal_x), bilinear(_normal_y)};
+    float     normal_length = glm::length(normal);
+    if (normal_length > 1e-6f) // Les normales peuvent s'annuler sur l'axe médian du cœur
+        normal /= normal_length;
+
+    size_t const nearest = index(cell.x + (f.x > 0.5f ? 1 : 0), cell.y + (f.y > 0.5f ? 1 : 0));
+    return HeartFieldSample{
+        .signed_distance = bilinear(_signed_distance),
+        .t               = _t[nearest],
+        .normal          = normal,
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include "glm/glm.hpp"
+
+// Ce que le champ de force a besoin de savoir sur le point du cœur le plus proche
+struct HeartFieldSample {
+    float     signed_distance; // Négative à l'intérieur du cœur
+    float     t;               // Paramètre du point le plus proche sur heart_curve()
+    glm::vec2 normal;          // Normale de la courbe en t (même orientation que heart_tangent())
+};
+
+// Champ de distance signée du cœur, précalculé une fois sur une grille régulière couvrant [min, max].
+// Une requête coûte une interpolation bilinéaire au lieu d'une recherche du point le plus proche.
+class HeartDistanceField {
+public:
+    // La grille est calculée en parallèle sur thread_pool()
+    HeartDistanceField(glm::vec2 min, glm::vec2 max, float cell_size);
+
+    bool contains(glm::vec2 position) const
+    {
+        return position.x >= _min.x && position.y >= _min.y && position.x <= _max.x && position.y <= _max.y;
+    }
+
+    // Distance et normale interpolées bilinéairement, t du nœud le plus proche (t n'est pas continu au
+    // point de raccord de la courbe, on ne l'interpole pas). position doit être dans la grille.
+    HeartFieldSample sample(glm::vec2 position) const;
+
+    // Grille brute, pour l'envoyer au GPU : le nœud (x, y) est en min() + (x, y) * cell_size(), à l'indice y * grid_size().x + x
+    glm::vec2                 min() const { return _min; }
+    glm::vec2                 cell_size() const { return _cell_size; }
+    glm::ivec2                grid_size() const { return _size; }
+    std::vector<float> const& signed_distances() const { return _signed_distance; }
+    std::vector<float> const& normals_x() const { return _normal_x; }
+    std::vector<float> const& normals_y() const { return _normal_y; }
+
+    // Calcul exact, sans la grille (utilisé pour remplir la grille et en dehors de celle-ci)
+    static HeartFieldSample compute(glm::vec2 position);
+
+private:
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * static_cast<size_t>(_size.x) + static_cast<size_t>(x); }
+
+private:
+    glm::vec2  _min;
+    glm::vec2  _max;
+    glm::ivec2 _size; // Nombre de nœuds dans chaque direction
+    glm::vec2  _cell_size;
+
+    std::vector<float> _signed_distance;
+    std::vector<float> _t;
+    std::vector<float> _normal_x;
+    std::vector<float> _normal_y;
+};
@@ -0,0 +1,39 @@
+#include "integrate.hpp"
+#include "simd.hpp"
+
+void integrate(ParticleStore& particles, size_t begin, size_t end, float dt)
+{
+    float* const px = particles.position_x.data();
+    float* const py = particles.position_y.data();
+    float* const vx = particles.velocity_x.data();
+    float* const vy = particles.velocity_y.data();
+    float const* ax = particles.acceleration_x.data();
+    float const* ay = particles.acceleration_y.data();
+
+    simd::float_v const dt_v = simd::broadcast(dt);
+
+    size_t i = begin;
+    for (; i + simd::width <= end; i += simd::width)
+    {
+        simd::float_v vel_x = simd::load(vx + i) + simd::load(ax + i) * dt_v;
+        simd::float_v vel_y = simd::load(vy + i) + simd::load(ay + i) * dt_v;
+        simd::store(vx + i, vel_x);
+        simd::store(vy + i, vel_y);
+        simd::store(px + i, simd::load(px + i) + vel_x * dt_v);
+        simd::store(py + i, simd::load(py + i) + vel_y * dt_v);
+    }
+
+    // Particules restantes (moins de simd::width)
+    integrate_scalar(particles, i, end, dt);
+}
+
+void integrate_scalar(ParticleStore& particles, size_t begin, size_t end, float dt)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        particles.velocity_x[i] += particles.acceleration_x[i] * dt;
+        particles.velocity_y[i] += particles.acceleration_y[i] * dt;
+        particles.position_x[i] += particles.velocity_x[i] * dt;
+        particles.position_y[i] += particles.velocity_y[i] * dt;
+    }
+}
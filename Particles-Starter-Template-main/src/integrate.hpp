@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include "particle_store.hpp"
+
+// Euler semi-implicite sur les particules [begin, end) : v += a * dt, puis p += v * dt.
+// L'accélération a est lue dans les colonnes acceleration_x / acceleration_y.
+//
+// integrate() traite simd::width particules par itération (SSE2 / AVX / AVX-512) puis finit les
+// particules restantes avec integrate_scalar(). Les deux versions font les mêmes opérations dans le
+// même ordre : les résultats sont identiques bit à bit, sauf si le compilateur fusionne les
+// multiplications-additions de la version scalaire en FMA (-ffp-contract=fast avec -march=native),
+// auquel cas l'écart reste inférieur à 1e-6 en relatif sur un pas.
+//
+// Écart avec la boucle d'origine : elle ajoutait chaque force à la vitesse séparément
+// (v += n · strength · dt, puis v += g · dt), alors qu'ici les forces sont d'abord sommées dans a
+// (cf. ForcePipeline) puis v += (n · strength + g) · dt. Les deux sont égales au réel près mais pas à
+// l'arrondi près : l'incrément de vitesse diffère d'au plus quelques ulp à chaque pas. Les trajectoires ne
+// sont donc pas identiques bit à bit à celles d'avant, et l'écart peut grandir au fil des pas pour les
+// particules qui frôlent le cœur, très sensibles aux petites perturbations.
+void integrate(ParticleStore& particles, size_t begin, size_t end, float dt);
+void integrate_scalar(ParticleStore& particles, size_t begin, size_t end, float dt);
+
+inline void integrate(ParticleStore& particles, float dt)
+{
+    integrate(particles, 0, particles.size(), dt);
+}
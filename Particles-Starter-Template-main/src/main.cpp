@@ -1,122 +1,252 @@
 #include "opengl-framework/opengl-framework.hpp"
+#include "disk_renderer.hpp"
+#include "gpu_simulation.hpp"
+#include "headless.hpp"
+#include "heart.hpp"
+#include "simulation.hpp"
+#include "simulation_clock.hpp"
+#include "static_curve.hpp"
+#include "thread_pool.hpp"
 #include "utils.hpp"
 #include <glm/glm.hpp>
-#include <glm/gtc/constants.hpp>
-#include <functional>
-#include <vector>
-
-void draw_parametric(std::function<glm::vec2(float)> const& parametric, int segments = 100, float thickness = 0.005f, glm::vec4 color = glm::vec4(1.f)) {
-    for (int i = 0; i < segments; ++i) {
-        float t1 = static_cast<float>(i) / segments;
-        float t2 = static_cast<float>(i + 1) / segments;
-        glm::vec2 p1 = parametric(t1);
-        glm::vec2 p2 = parametric(t2);
-        utils::draw_line(p1, p2, thickness, color);
-    }
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+// Le contour ne change pas : découpé une fois en mesh, redessiné tel quel à chaque frame
+StaticCurve make_heart_outline() {
+    return StaticCurve{heart_curve, 300, 0.005f, glm::vec4(1.f, 0.f, 0.f, 1.f)};
 }
 
-// Courbe de cœur : t ∈ [0, 1]
-glm::vec2 heart_curve(float t) {
-    float angle = t * glm::two_pi<float>(); // t ∈ [0, 1] → angle ∈ [0, 2π]
-    float x = 16.f * std::pow(std::sin(angle), 3.f);
-    float y = 13.f * std::cos(angle) - 5.f * std::cos(2.f * angle) - 2.f * std::cos(3.f * angle) - std::cos(4.f * angle);
-    return glm::vec2(x, y) / 18.f; // Normalisation dans [-1,1]
+void print_usage() {
+    std::cout << "Options :\n"
+                 "  --headless <pas>   Simule <pas> pas sans fenêtre et affiche le débit\n"
+                 "  --dt <secondes>    Durée d'un pas en mode headless (défaut 1/120)\n"
+                 "  --dump <fichier>   Écrit l'état final en CSV (mode headless)\n"
+                 "  --threads <n>      Nombre de threads de simulation (défaut : tous les cœurs)\n"
+                 "  --seed <n>         Graine des tirages aléatoires : même graine, mêmes particules (défaut : au hasard)\n"
+                 "  --exact            Point le plus proche du cœur calculé exactement, sans la grille précalculée\n"
+                 "  --particles <n>    Nombre maximum de particules (défaut 100000)\n"
+                 "  --rain <n>         Particules créées à chaque pas (défaut 5)\n"
+                 "  --collisions       Collisions entre particules (CPU uniquement)\n"
+                 "  --attraction <G>   Attraction entre particules (négative : répulsion), par Barnes–Hut (CPU uniquement)\n"
+                 "  --theta <θ>        Angle d'ouverture de Barnes–Hut (défaut 0.5, 0 : somme exacte)\n"
+                 "  --solid-heart      Les particules rebondissent sur le cœur sans jamais le traverser (CPU uniquement)\n"
+                 "  --emitter <n>      Particules créées à chaque pas le long du cœur, par un émetteur qui en fait le tour (CPU uniquement)\n"
+                 "  --emission <nom>   Répartition de la pluie : uniform (défaut), halton, sobol, r2, blue-noise (CPU uniquement)\n"
+                 "  --gpu              Simulation en compute shaders (OpenGL 4.3), avec fenêtre uniquement ; sinon, sur le CPU\n";
 }
 
-// Approximation de la tangente (dérivée numérique centrée)
-glm::vec2 heart_tangent(float t, float epsilon = 0.001f) {
-    glm::vec2 p1 = heart_curve(glm::clamp(t - epsilon, 0.f, 1.f));
-    glm::vec2 p2 = heart_curve(glm::clamp(t + epsilon, 0.f, 1.f));
-    return glm::normalize(p2 - p1);
+// Arguments numériques : tout le texte doit être un nombre dans les bornes (atoi / atof acceptaient n'importe quoi)
+std::optional<long long> parse_integer(char const* text, long long min, long long max) {
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || value < min || value > max)
+        return std::nullopt;
+    return value;
 }
 
-// Descente de gradient pour trouver le t de la courbe du cœur le plus proche d’un point donné
-float find_closest_t_on_heart(glm::vec2 point) {
-    float t = 0.5f;
-    float lr = 0.01f;
-    int max_iter = 100;
-
-    for (int i = 0; i < max_iter; ++i) {
-        glm::vec2 curve_pos = heart_curve(t);
-        glm::vec2 tangent = heart_tangent(t);
-        glm::vec2 diff = curve_pos - point;
-
-        // Gradient de ||C(t) - p||² = 2 * dot(diff, tangent)
-        float grad = 2.f * glm::dot(diff, tangent);
-        t -= lr * grad;
-        t = glm::clamp(t, 0.f, 1.f);
-        if (std::abs(grad) < 1e-5f) break;
-    }
+std::optional<uint64_t> parse_unsigned(char const* text) {
+    // strtoull accepte un signe moins (et rend alors 2^64 - n) : on n'accepte que des chiffres
+    if (*text < '0' || *text > '9')
+        return std::nullopt;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE)
+        return std::nullopt;
+    return static_cast<uint64_t>(value);
+}
 
-    return t;
+std::optional<float> parse_real(char const* text) {
+    char* end = nullptr;
+    errno = 0;
+    float value = std::strtof(text, &end);
+    if (end == text || *end != '\0' || errno == ERANGE || !std::isfinite(value))
+        return std::nullopt;
+    return value;
 }
 
-struct Particle {
-    glm::vec2 position;
-    glm::vec2 velocity;
-    float radius = 0.008f;
+int invalid_value(std::string_view option, char const* value) {
+    std::cerr << "Valeur invalide pour " << option << " : " << value << "\n";
+    print_usage();
+    return 1;
+}
 
-    Particle(glm::vec2 pos) : position(pos), velocity(0.f) {}
+// Même simulation entièrement sur le GPU : rien ne repasse par le CPU entre deux frames
+int run_window_gpu(GpuSimulation& simulation, HeadlessOptions const& options) {
+    simulation.seed = static_cast<uint32_t>(utils::random_seed());
+    simulation.rain_per_step = options.rain_per_step;
+    SimulationClock clock{};
+    StaticCurve heart_outline = make_heart_outline();
 
-    void update(float dt) {
-        position += velocity * dt;
-    }
+    while (gl::window_is_open()) {
+        float aspect = gl::framebuffer_aspect_ratio();
 
-    glm::vec4 color() const {
-        return glm::vec4(1.f);
-    }
-};
+        glClearColor(0.f, 0.f, 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
 
-std::vector<Particle> particles;
+        int substeps = clock.advance(gl::delta_time_in_seconds());
+        for (int step = 0; step < substeps; ++step)
+            simulation.step(clock.fixed_dt, aspect);
 
-void spawn_rain_particles(float aspect_ratio) {
-    for (int i = 0; i < 5; ++i) {
-        float x = utils::rand(-aspect_ratio, aspect_ratio);
-        float y = 1.1f;
-        particles.emplace_back(glm::vec2(x, y));
+        heart_outline.draw();
+        simulation.draw(clock.interpolation_alpha(), 0.008f, glm::vec4(1.f));
     }
-}
 
-void draw_heart_outline() {
-    draw_parametric(heart_curve, 300, 0.005f, glm::vec4(1.f, 0.f, 0.f, 1.f));
+    std::cout << "Particules : " << simulation.read_size() << " / " << simulation.capacity() << " à la fin\n";
+    std::cout << "Temps abandonné (frames trop lentes) : " << clock.dropped_time() << " s\n";
+
+    return 0;
 }
 
-int main() {
+// Les réglages de la simulation sont partagés avec le mode headless (steps, dt et dump_path sont ignorés)
+int run_window(HeadlessOptions const& options, bool use_gpu) {
     gl::init("Champ de force autour d'un cœur");
     gl::maximize_window();
 
+    if (use_gpu) {
+        std::optional<GpuSimulation> gpu_simulation{};
+        if (!GpuSimulation::is_supported()) {
+            std::cerr << "OpenGL 4.3 indisponible (compute shaders) : simulation sur le CPU\n";
+        } else {
+            try {
+                gpu_simulation.emplace(options.max_particles);
+            } catch (std::runtime_error const&) { // Le journal du pilote est déjà affiché
+                std::cerr << "Compute shaders refusés par le pilote : simulation sur le CPU\n";
+            }
+        }
+        if (gpu_simulation)
+            return run_window_gpu(*gpu_simulation, options);
+    }
+
+    Simulation simulation{options.max_particles};
+    simulation.use_distance_field = options.use_distance_field;
+    simulation.rain_per_step = options.rain_per_step;
+    simulation.collide_particles = options.collide_particles;
+    simulation.particle_attraction = options.particle_attraction;
+    simulation.attraction_tree.theta = options.theta;
+    simulation.collide_with_heart = options.collide_with_heart;
+    simulation.heart_emitter_per_step = options.heart_emitter_per_step;
+    simulation.set_rain_pattern(options.rain_pattern);
+    simulation.prepare(); // Avant la boucle : la première frame ne paie pas la grille de distance
+    ParticleStore const& particles = simulation.particles;
+    SimulationClock clock{};
+    DiskRenderer disks{};
+    StaticCurve heart_outline = make_heart_outline();
+
     while (gl::window_is_open()) {
-        float dt = gl::delta_time_in_seconds();
         float aspect = gl::framebuffer_aspect_ratio();
 
         glClearColor(0.f, 0.f, 0.f, 1.f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        draw_heart_outline();
-        spawn_rain_particles(aspect);
+        // Pas fixes : une frame lente donne plusieurs petits pas au lieu d'un grand
+        int substeps = clock.advance(gl::delta_time_in_seconds());
+        for (int step = 0; step < substeps; ++step)
+            simulation.step(clock.fixed_dt, aspect);
 
-        for (auto& p : particles) {
-            float t_closest = find_closest_t_on_heart(p.position);
-            glm::vec2 curve_point = heart_curve(t_closest);
-            glm::vec2 tangent = heart_tangent(t_closest);
-            glm::vec2 normal = glm::normalize(glm::vec2(-tangent.y, tangent.x));
+        heart_outline.draw();
 
-            glm::vec2 delta = p.position - curve_point;
-            float distance = glm::length(delta);
+        // Toutes les particules en un seul draw call
+        float alpha = clock.interpolation_alpha();
+        disks.reserve(particles.size());
+        for (size_t i = 0; i < particles.size(); ++i)
+            disks.submit(particles.interpolated_position(i, alpha), particles.radius, glm::vec4(1.f));
+        disks.flush();
+    }
 
-            float strength = 5.f * std::exp(-distance * 10.f);
-            p.velocity += normal * strength * dt;
+    std::cout << "Particules : max " << particles.high_water_mark() << " / " << particles.capacity()
+              << ", " << particles.rejected_spawns() << " non créées (pool plein)\n";
+    std::cout << "Temps abandonné (frames trop lentes) : " << clock.dropped_time() << " s\n";
 
-            p.velocity += glm::vec2(0.f, -0.4f) * dt; // gravité
-            p.update(dt);
+    return 0;
+}
 
-            utils::draw_disk(p.position, p.radius, p.color());
+int main(int argc, char** argv) {
+    bool headless = false;
+    bool use_gpu = false;
+    HeadlessOptions options{};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--headless" && has_value) {
+            headless = true;
+            std::optional<long long> steps = parse_integer(argv[++i], 1, std::numeric_limits<int>::max());
+            if (!steps)
+                return invalid_value(arg, argv[i]);
+            options.steps = static_cast<int>(*steps);
+        } else if (arg == "--dt" && has_value) {
+            std::optional<float> dt = parse_real(argv[++i]);
+            if (!dt || *dt <= 0.f)
+                return invalid_value(arg, argv[i]);
+            options.dt = *dt;
+        } else if (arg == "--dump" && has_value) {
+            options.dump_path = argv[++i];
+        } else if (arg == "--exact") {
+            options.use_distance_field = false;
+        } else if (arg == "--particles" && has_value) {
+            std::optional<long long> particles = parse_integer(argv[++i], 1, std::numeric_limits<long long>::max());
+            if (!particles)
+                return invalid_value(arg, argv[i]);
+            options.max_particles = static_cast<size_t>(*particles);
+        } else if (arg == "--rain" && has_value) {
+            std::optional<long long> rain = parse_integer(argv[++i], 0, std::numeric_limits<int>::max());
+            if (!rain)
+                return invalid_value(arg, argv[i]);
+            options.rain_per_step = static_cast<int>(*rain);
+        } else if (arg == "--collisions") {
+            options.collide_particles = true;
+        } else if (arg == "--attraction" && has_value) {
+            std::optional<float> attraction = parse_real(argv[++i]);
+            if (!attraction)
+                return invalid_value(arg, argv[i]);
+            options.particle_attraction = *attraction;
+        } else if (arg == "--theta" && has_value) {
+            std::optional<float> theta = parse_real(argv[++i]);
+            if (!theta || *theta < 0.f)
+                return invalid_value(arg, argv[i]);
+            options.theta = *theta;
+        } else if (arg == "--solid-heart") {
+            options.collide_with_heart = true;
+        } else if (arg == "--emitter" && has_value) {
+            std::optional<long long> emitter = parse_integer(argv[++i], 0, std::numeric_limits<int>::max());
+            if (!emitter)
+                return invalid_value(arg, argv[i]);
+            options.heart_emitter_per_step = static_cast<int>(*emitter);
+        } else if (arg == "--emission" && has_value) {
+            std::optional<PointPattern> pattern = point_pattern_from_name(argv[++i]);
+            if (!pattern)
+                return invalid_value(arg, argv[i]);
+            options.rain_pattern = *pattern;
+        } else if (arg == "--gpu") {
+            use_gpu = true;
+        } else if (arg == "--seed" && has_value) {
+            std::optional<uint64_t> seed = parse_unsigned(argv[++i]);
+            if (!seed)
+                return invalid_value(arg, argv[i]);
+            utils::set_random_seed(*seed);
+        } else if (arg == "--threads" && has_value) {
+            std::optional<long long> threads = parse_integer(argv[++i], 1, 1024);
+            if (!threads)
+                return invalid_value(arg, argv[i]);
+            set_thread_pool_size(static_cast<size_t>(*threads));
+        } else {
+            print_usage();
+            return arg == "--help" ? 0 : 1;
         }
-
-        particles.erase(std::remove_if(particles.begin(), particles.end(), [](auto const& p) {
-            return p.position.y < -1.2f;
-        }), particles.end());
     }
 
-    return 0;
-}
\ No newline at end of file
+    if (headless && use_gpu)
+        std::cerr << "--gpu demande un contexte OpenGL : ignoré en mode headless\n";
+    return headless ? run_headless(options) : run_window(options, use_gpu);
+}
@@ -0,0 +1,87 @@
+#include "particle_store.hpp"
+#include <algorithm>
+#include <cmath>
+
+ParticleStore::ParticleStore(size_t capacity)
+    : position_x(capacity)
+    , position_y(capacity)
+    , previous_position_x(capacity)
+    , previous_position_y(capacity)
+    , velocity_x(capacity)
+    , velocity_y(capacity)
+    , acceleration_x(capacity)
+    , acceleration_y(capacity)
+    , closest_t(capacity)
+    , closest_anchor_x(capacity)
+    , closest_anchor_y(capacity)
+    , age(capacity)
+    , lifetime(capacity)
+{}
+
+bool ParticleStore::spawn(glm::vec2 position, glm::vec2 velocity, float lifetime)
+{
+    if (full())
+    {
+        ++_rejected_spawns;
+        return false;
+    }
+    respawn(_count, position, velocity, lifetime);
+    ++_count;
+    _high_water_mark = std::max(_high_water_mark, _count);
+    return true;
+}
+
+void ParticleStore::respawn(size_t i, glm::vec2 position, glm::vec2 velocity, float lifetime)
+{
+    position_x[i] = position.x;
+    position_y[i] = position.y;
+    initialize_spawned(i, velocity, lifetime);
+}
+
+void ParticleStore::initialize_spawned(size_t i, glm::vec2 velocity, float lifetime)
+{
+    previous_position_x[i] = position_x[i];
+    previous_position_y[i] = position_y[i];
+    velocity_x[i]          = velocity.x;
+    velocity_y[i]          = velocity.y;
+    acceleration_x[i]      = 0.f;
+    acceleration_y[i]      = 0.f;
+    closest_t[i]           = NAN;
+    closest_anchor_x[i]    = position_x[i];
+    closest_anchor_y[i]    = position_y[i];
+    age[i]                 = 0.f;
+    this->lifetime[i]      = lifetime;
+}
+
+void ParticleStore::initialize_spawned(size_t begin, size_t end, glm::vec2 velocity, float lifetime)
+{
+    for (size_t i = begin; i < end; ++i)
+        initialize_spawned(i, velocity, lifetime);
+    _count           = end;
+    _high_water_mark = std::max(_high_water_mark, _count);
+}
+
+void ParticleStore::save_previous_positions(size_t begin, size_t end)
+{
+    std::copy(position_x.begin() + begin, position_x.begin() + end, previous_position_x.begin() + begin);
+    std::copy(position_y.begin() + begin, position_y.begin() + end, previous_position_y.begin() + begin);
+}
+
+void ParticleStore::swap_remove(size_t i)
+{
+    size_t const last = _count - 1;
+    position_x[i]          = position_x[last];
+    position_y[i]          = position_y[last];
+    previous_position_x[i] = previous_position_x[last];
+    previous_position_y[i] = previous_position_y[last];
+    velocity_x[i]          = velocity_x[last];
+    velocity_y[i]          = velocity_y[last];
+    acceleration_x[i]      = acceleration_x[last];
+    acceleration_y[i]      = acceleration_y[last];
+    closest_t[i]           = closest_t[last];
+    closest_anchor_x[i]    = closest_anchor_x[last];
+    closest_anchor_y[i]    = closest_anchor_y[last];
+    age[i]                 = age[last];
+    lifetime[i]            = lifetime[last];
+    --_count;
+}
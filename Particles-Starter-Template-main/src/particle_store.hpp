@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Particules stockées en colonnes (Structure of Arrays) : chaque attribut est contigu en mémoire,
+// une boucle ne lit que les colonnes dont elle a besoin.
+// Le pool a une capacité fixe, allouée une seule fois à la construction : les particules vivantes
+// occupent les emplacements [0, size()), et aucune allocation n'a lieu pendant la simulation.
+struct ParticleStore {
+    explicit ParticleStore(size_t capacity);
+
+    // Chaque colonne fait capacity() éléments, seuls les size() premiers sont valides
+    std::vector<float> position_x;
+    std::vector<float> position_y;
+    std::vector<float> previous_position_x; // Position au pas précédent, pour interpoler le rendu
+    std::vector<float> previous_position_y;
+    std::vector<float> velocity_x;
+    std::vector<float> velocity_y;
+    std::vector<float> acceleration_x; // Somme des forces du pas en cours, lue par integrate()
+    std::vector<float> acceleration_y;
+    std::vector<float> closest_t;        // t du point du cœur le plus proche au dernier pas (NaN : inconnu)
+    std::vector<float> closest_anchor_x; // Position lors de la dernière recherche complète de ce point
+    std::vector<float> closest_anchor_y;
+    std::vector<float> age;
+    std::vector<float> lifetime;
+
+    float radius = 0.008f; // Identique pour toutes les particules
+
+    size_t size() const { return _count; }
+    size_t capacity() const { return position_x.size(); }
+    bool   empty() const { return _count == 0; }
+    bool   full() const { return _count == capacity(); }
+
+    // Plus grand nombre de particules vivantes atteint depuis la création du pool
+    size_t high_water_mark() const { return _high_water_mark; }
+    // Nombre de particules qui n'ont pas pu être créées parce que le pool était plein
+    size_t rejected_spawns() const { return _rejected_spawns; }
+
+    void clear() { _count = 0; }
+
+    // Ajoute une particule à la fin des particules vivantes. Renvoie false si le pool est plein.
+    bool spawn(glm::vec2 position, glm::vec2 velocity = glm::vec2(0.f), float lifetime = 0.f);
+    // Réutilise sur place l'emplacement i (typiquement celui d'une particule morte)
+    void respawn(size_t i, glm::vec2 position, glm::vec2 velocity = glm::vec2(0.f), float lifetime = 0.f);
+
+    // Ajoute count particules d'un coup (moins si le pool est plein) et renvoie le nombre ajouté.
+    // fill_positions(x, y) écrit directement leurs positions dans les colonnes position_x / position_y
+    // (par exemple avec un sampler de samplers.hpp) ; le reste est initialisé comme par spawn().
+    template<typename FillPositions>
+    size_t spawn_batch(size_t count, FillPositions&& fill_positions, glm::vec2 velocity = glm::vec2(0.f), float lifetime = 0.f)
+    {
+        size_t const first = _count;
+        size_t const added = std::min(count, capacity() - _count);
+        _rejected_spawns += count - added;
+        fill_positions(std::span<float>{position_x.data() + first, added}, std::span<float>{position_y.data() + first, added});
+        initialize_spawned(first, first + added, velocity, lifetime);
+        return added;
+    }
+
+    glm::vec2 position(size_t i) const { return {position_x[i], position_y[i]}; }
+    glm::vec2 velocity(size_t i) const { return {velocity_x[i], velocity_y[i]}; }
+    // Position interpolée entre le pas précédent (alpha = 0) et le pas courant (alpha = 1)
+    glm::vec2 interpolated_position(size_t i, float alpha) const
+    {
+        return glm::mix(glm::vec2{previous_position_x[i], previous_position_y[i]}, position(i), alpha);
+    }
+
+    // À appeler au début de chaque pas, avant de déplacer les particules [begin, end)
+    void save_previous_positions(size_t begin, size_t end);
+
+    // Supprime la particule i en la remplaçant par la dernière : O(1), mais l'ordre n'est pas conservé
+    void swap_remove(size_t i);
+
+    // Supprime toutes les particules i telles que is_dead(i), en ne déplaçant que les particules mortes
+    template<typename Predicate>
+    size_t remove_if(Predicate&& is_dead)
+    {
+        size_t removed = 0;
+        size_t i       = 0;
+        while (i < size())
+        {
+            if (is_dead(i))
+            {
+                swap_remove(i); // La dernière particule prend la place i : on la teste au prochain tour
+                ++removed;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return removed;
+    }
+
+private:
+    // État d'une particule qui apparaît, à partir de sa position déjà écrite (seul endroit qui liste les colonnes à
+    // initialiser : partagé par respawn() et spawn_batch())
+    void initialize_spawned(size_t i, glm::vec2 velocity, float lifetime);
+    // Fin de spawn_batch() : les positions [begin, end) sont déjà écrites
+    void initialize_spawned(size_t begin, size_t end, glm::vec2 velocity, float lifetime);
+
+private:
+    size_t _count{0};
+    size_t _high_water_mark{0};
+    size_t _rejected_spawns{0};
+};
@@ -0,0 +1,335 @@
+#include "point_sequences.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+// Les 24 bits de poids fort d'une coordonnée en virgule fixe 32 bits -> [0, 1)
+static float fixed_to_unit(uint32_t bits)
+{
+    return static_cast<float>(static_cast<int32_t>(bits >> 8)) * 0x1p-24f;
+}
+
+// Partie fractionnaire, ramenée sous 1 (1 - ε arrondi en float donnerait 1)
+static float wrap_unit(float x)
+{
+    return std::min(x - std::floor(x), 0x1.fffffep-1f);
+}
+
+UniformPoints::UniformPoints(utils::RandomStream random)
+    : _random{random}
+{}
+
+void UniformPoints::fill(std::span<float> u, std::span<float> v)
+{
+    _random.fill(u, 0.f, 1.f);
+    _random.fill(v, 0.f, 1.f);
+}
+
+static double radical_inverse(uint32_t index, uint32_t base)
+{
+    double const inverse_base = 1. / base;
+    double       factor       = inverse_base;
+    double       result       = 0.;
+    while (index > 0)
+    {
+        result += (index % base) * factor;
+        index /= base;
+        factor *= inverse_base;
+    }
+    return result;
+}
+
+HaltonSequence::HaltonSequence(utils::RandomStream random)
+{
+    _offset = {random.uniform(0.f, 1.f), random.uniform(0.f, 1.f)};
+}
+
+void HaltonSequence::fill(std::span<float> u, std::span<float> v)
+{
+    for (size_t i = 0; i < u.size(); ++i, ++_index)
+    {
+        u[i] = wrap_unit(static_cast<float>(radical_inverse(_index, 2)) + _offset.x);
+        v[i] = wrap_unit(static_cast<float>(radical_inverse(_index, 3)) + _offset.y);
+    }
+}
+
+// Nombres directeurs des deux premières dimensions de Sobol : v_k = 2^(31 - k), et v_k = v_{k-1} ^ (v_{k-1} >> 1)
+// (polynôme primitif x + 1)
+static constexpr std::array<std::array<uint32_t, 32>, 2> sobol_directions = []() {
+    std::array<std::array<uint32_t, 32>, 2> directions{};
+    uint32_t                                previous = 0;
+    for (int k = 0; k < 32; ++k)
+    {
+        directions[0][k] = uint32_t{1} << (31 - k);
+        directions[1][k] = k == 0 ? uint32_t{1} << 31 : previous ^ (previous >> 1);
+        previous         = directions[1][k];
+    }
+    return directions;
+}();
+
+SobolSequence::SobolSequence(utils::RandomStream random)
+{
+    _scramble_u = random.next_bits();
+    _scramble_v = random.next_bits();
+}
+
+void SobolSequence::fill(std::span<float> u, std::span<float> v)
+{
+    for (size_t i = 0; i < u.size(); ++i, ++_index)
+    {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        for (uint32_t bits = _index; bits != 0; bits &= bits - 1)
+        {
+            int const k = std::countr_zero(bits);
+            x ^= sobol_directions[0][k];
+            y ^= sobol_directions[1][k];
+        }
+        u[i] = fixed_to_unit(x ^ _scramble_u);
+        v[i] = fixed_to_unit(y ^ _scramble_v);
+    }
+}
+
+// 1/φ₂ et 1/φ₂² en virgule fixe 32 bits, φ₂ = 1.32471795724474602596 (racine réelle de x³ = x + 1)
+static constexpr uint32_t r2_step_u = 3242174889u;
+static constexpr uint32_t r2_step_v = 2447445414u;
+
+R2Sequence::R2Sequence(utils::RandomStream random)
+{
+    _offset_u = random.next_bits();
+    _offset_v = random.next_bits();
+}
+
+void R2Sequence::fill(std::span<float> u, std::span<float> v)
+{
+    uint32_t const first = _index;
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        uint32_t const n = first + static_cast<uint32_t>(i);
+        u[i]             = fixed_to_unit(_offset_u + n * r2_step_u);
+        v[i]             = fixed_to_unit(_offset_v + n * r2_step_v);
+    }
+    _index = first + static_cast<uint32_t>(u.size());
+}
+
+// Distance sur le tore : la table se répète sans couture
+static float torus_distance2(glm::vec2 a, glm::vec2 b)
+{
+    glm::vec2 d = glm::abs(a - b);
+    d           = glm::min(d, 1.f - d);
+    return glm::dot(d, d);
+}
+
+std::vector<glm::vec2> poisson_disk_points(float min_distance, utils::RandomStream& random)
+{
+    // Grille de cases de côté au plus min_distance / √2 : au plus un point par case
+    static constexpr int candidates_per_point = 30;
+    int const            grid_size            = std::max(1, static_cast<int>(std::ceil(std::numbers::sqrt2_v<float> / min_distance)));
+    std::vector<int32_t> grid(static_cast<size_t>(grid_size) * static_cast<size_t>(grid_size), -1);
+
+    auto const cell_of = [&](glm::vec2 p) {
+        return glm::ivec2{std::min(static_cast<int>(p.x * grid_size), grid_size - 1), std::min(static_cast<int>(p.y * grid_size), grid_size - 1)};
+    };
+    std::vector<glm::vec2> points{};
+    std::vector<size_t>    active{};
+    auto const             add = [&](glm::vec2 p) {
+        glm::ivec2 const cell = cell_of(p);
+        grid[static_cast<size_t>(cell.y) * static_cast<size_t>(grid_size) + static_cast<size_t>(cell.x)] = static_cast<int32_t>(points.size());
+        active.push_back(points.size());
+        points.push_back(p);
+    };
+    auto const far_enough = [&](glm::vec2 p) {
+        glm::ivec2 const cell = cell_of(p);
+        for (int dy = -2; dy <= 2; ++dy)
+        {
+            for (int dx = -2; dx <= 2; ++dx)
+            {
+                int const     x        = (cell.x + dx + grid_size) % grid_size;
+                int const     y        = (cell.y + dy + grid_size) % grid_size;
+                int32_t const neighbor = grid[static_cast<size_t>(y) * static_cast<size_t>(grid_size) + static_cast<size_t>(x)];
+                if (neighbor >= 0 && torus_distance2(p, points[static_cast<size_t>(neighbor)]) < min_distance * min_distance)
+                    return false;
+            }
+        }
+        return true;
+    };
+
+    add({random.uniform(0.f, 1.f), random.uniform(0.f, 1.f)});
+    while (!active.empty())
+    {
+        size_t const    slot   = static_cast<size_t>(random.uniform_int(0, static_cast<int>(active.size()) - 1));
+        glm::vec2 const center = points[active[slot]];
+        bool            found  = false;
+        for (int k = 0; k < candidates_per_point && !found; ++k)
+        {
+            // Candidat dans l'anneau [d, 2d] autour du point actif
+            float const     angle     = random.uniform(0.f, 2.f * std::numbers::pi_v<float>);
+            float const     distance  = min_distance * std::sqrt(random.uniform(1.f, 4.f));
+            glm::vec2 const candidate = center + distance * glm::vec2{std::cos(angle), std::sin(angle)};
+            glm::vec2 const wrapped   = {wrap_unit(candidate.x), wrap_unit(candidate.y)};
+            if (far_enough(wrapped))
+            {
+                add(wrapped);
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            active[slot] = active.back();
+            active.pop_back();
+        }
+    }
+    return points;
+}
+
+// Réordonne les points pour que tout début de la liste soit bien réparti : chaque point est celui qui est le plus loin
+// de tous ceux qui le précèdent (échantillonnage du point le plus lointain, en O(n²))
+static void sort_farthest_first(std::vector<glm::vec2>& points)
+{
+    std::vector<float> distance2(points.size(), std::numeric_limits<float>::infinity());
+    for (size_t i = 0; i + 1 < points.size(); ++i)
+    {
+        size_t farthest = i + 1;
+        for (size_t j = i + 1; j < points.size(); ++j)
+        {
+            distance2[j] = std::min(distance2[j], torus_distance2(points[i], points[j]));
+            if (distance2[j] > distance2[farthest])
+                farthest = j;
+        }
+        std::swap(points[i + 1], points[farthest]);
+        std::swap(distance2[i + 1], distance2[farthest]);
+    }
+}
+
+std::span<glm::vec2 const> BlueNoisePoints::table()
+{
+    // Distance pour environ 4096 points (Bridson remplit un peu moins qu'un empilement hexagonal). Graine fixe :
+    // la table est la même à chaque lancement, seuls les décalages dépendent de la graine de la source.
+    // Bridson rend les points dans l'ordre où il les fait pousser, de proche en proche : on les réordonne.
+    static std::vector<glm::vec2> const points = []() {
+        utils::RandomStream    random{0x5eed};
+        std::vector<glm::vec2> table = poisson_disk_points(std::sqrt(0.62f / 4096.f), random);
+        sort_farthest_first(table);
+        return table;
+    }();
+    return points;
+}
+
+std::span<float const> BlueNoisePoints::table_1d()
+{
+    // Un point par intervalle de 1 / 4096, dans sa première moitié : deux voisins sont à au moins un demi-intervalle
+    // l'un de l'autre, y compris à travers 0 / 1. Réordonnés comme la table 2D (sur l'axe y = 0 du tore).
+    static std::vector<float> const points = []() {
+        static constexpr size_t count = 4096;
+        utils::RandomStream     random{0x5eed};
+        std::vector<glm::vec2>  table(count);
+        for (size_t k = 0; k < count; ++k)
+            table[k] = {(static_cast<float>(k) + random.uniform(0.f, 0.5f)) / static_cast<float>(count), 0.f};
+        sort_farthest_first(table);
+        std::vector<float> x(count);
+        for (size_t k = 0; k < count; ++k)
+            x[k] = table[k].x;
+        return x;
+    }();
+    return points;
+}
+
+BlueNoisePoints::BlueNoisePoints(utils::RandomStream random)
+    : _random{random}
+{
+    _offset    = {_random.uniform(0.f, 1.f), _random.uniform(0.f, 1.f)};
+    _offset_1d = _random.uniform(0.f, 1.f);
+}
+
+void BlueNoisePoints::fill(std::span<float> u, std::span<float> v)
+{
+    std::span<glm::vec2 const> const points = table();
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        if (_next == points.size())
+        {
+            _next   = 0;
+            _offset = {_random.uniform(0.f, 1.f), _random.uniform(0.f, 1.f)};
+        }
+        glm::vec2 const p = points[_next++];
+        u[i]              = wrap_unit(p.x + _offset.x);
+        v[i]              = wrap_unit(p.y + _offset.y);
+    }
+}
+
+void BlueNoisePoints::fill(std::span<float> u)
+{
+    std::span<float const> const points = table_1d();
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        if (_next_1d == points.size())
+        {
+            _next_1d   = 0;
+            _offset_1d = _random.uniform(0.f, 1.f);
+        }
+        u[i] = wrap_unit(points[_next_1d++] + _offset_1d);
+    }
+}
+
+std::optional<PointPattern> point_pattern_from_name(std::string_view name)
+{
+    if (name == "uniform")
+        return PointPattern::Uniform;
+    if (name == "halton")
+        return PointPattern::Halton;
+    if (name == "sobol")
+        return PointPattern::Sobol;
+    if (name == "r2")
+        return PointPattern::R2;
+    if (name == "blue-noise")
+        return PointPattern::BlueNoise;
+    return std::nullopt;
+}
+
+static std::variant<UniformPoints, HaltonSequence, SobolSequence, R2Sequence, BlueNoisePoints> make_source(PointPattern pattern, utils::RandomStream random)
+{
+    switch (pattern)
+    {
+    case PointPattern::Halton: return HaltonSequence{random};
+    case PointPattern::Sobol: return SobolSequence{random};
+    case PointPattern::R2: return R2Sequence{random};
+    case PointPattern::BlueNoise: return BlueNoisePoints{random};
+    case PointPattern::Uniform: break;
+    }
+    return UniformPoints{random};
+}
+
+PointSource::PointSource(PointPattern pattern, utils::RandomStream random)
+    : _pattern{pattern}
+    , _source{make_source(pattern, random)}
+{}
+
+void PointSource::fill(std::span<float> u, std::span<float> v)
+{
+    std::visit([&](auto& source) { source.fill(u, v); }, _source);
+}
+
+void PointSource::fill(std::span<float> u)
+{
+    std::visit(
+        [&](auto& source) {
+            if constexpr (requires { source.fill(u); })
+            {
+                source.fill(u);
+            }
+            else
+            {
+                // v tiré dans un tampon et jeté : la première coordonnée d'une suite est déjà une suite 1D régulière
+                std::array<float, 256> v;
+                for (size_t i = 0; i < u.size(); i += v.size())
+                {
+                    size_t const count = std::min(v.size(), u.size() - i);
+                    source.fill(u.subspan(i, count), std::span<float>{v.data(), count});
+                }
+            }
+        },
+        _source);
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "glm/glm.hpp"
+#include "utils.hpp"
+
+// Sources de points (u, v) du carré unité [0, 1)², à donner aux warps de samplers.hpp (sample(shape, source, x, y)).
+// Des tirages indépendants forment des amas et laissent des trous : les suites à faible discrépance (Halton, Sobol, R2)
+// et les tables de bruit bleu couvrent le carré régulièrement, donc moins de particules suffisent pour le même rendu.
+// Chaque source a fill(u, v), qui continue la suite là où l'appel précédent s'est arrêté. Une graine décale la suite
+// (décalage aléatoire modulo 1, tiré dans le flux donné au constructeur) : deux graines donnent deux suites
+// différentes, aussi régulières l'une que l'autre.
+
+// Tirages indépendants (la référence)
+class UniformPoints {
+public:
+    explicit UniformPoints(utils::RandomStream random);
+    void fill(std::span<float> u, std::span<float> v);
+
+private:
+    utils::RandomStream _random;
+};
+
+// Inverses radicaux en bases 2 et 3
+class HaltonSequence {
+public:
+    explicit HaltonSequence(utils::RandomStream random);
+    void fill(std::span<float> u, std::span<float> v);
+
+private:
+    uint32_t  _index{1}; // On saute le point 0, (0, 0) avant décalage
+    glm::vec2 _offset;
+};
+
+// Sobol à deux dimensions, en virgule fixe 32 bits, brouillé par un XOR (décalage digital)
+class SobolSequence {
+public:
+    explicit SobolSequence(utils::RandomStream random);
+    void fill(std::span<float> u, std::span<float> v);
+
+private:
+    uint32_t _index{0};
+    uint32_t _scramble_u;
+    uint32_t _scramble_v;
+};
+
+// Suite additive de M. Roberts : n · (1/φ₂, 1/φ₂²) modulo 1, avec φ₂ le nombre plastique. En virgule fixe 32 bits :
+// le modulo est gratuit et la boucle se vectorise.
+class R2Sequence {
+public:
+    explicit R2Sequence(utils::RandomStream random);
+    void fill(std::span<float> u, std::span<float> v);
+
+private:
+    uint32_t _index{0};
+    uint32_t _offset_u;
+    uint32_t _offset_v;
+};
+
+// Table de bruit bleu (Poisson-disk) calculée une fois sur le tore [0, 1)² : aucun point n'est plus proche
+// qu'une distance minimale de ses voisins, y compris à travers les bords, donc la table se répète sans couture.
+// Les points sont rendus dans l'ordre de la table ; à chaque tour, la table est décalée d'un vecteur aléatoire.
+// La projection de la table sur un axe n'a pas d'espacement minimal : fill(u) seul lit une table 1D à part.
+class BlueNoisePoints {
+public:
+    explicit BlueNoisePoints(utils::RandomStream random);
+    void fill(std::span<float> u, std::span<float> v);
+    void fill(std::span<float> u);
+
+    // Table partagée par toutes les sources (environ 4096 points, calculée au premier appel), dans un ordre où tout début de table est bien réparti
+    static std::span<glm::vec2 const> table();
+    // Même chose sur le cercle [0, 1) : 4096 points, à au moins 0.5 / 4096 les uns des autres
+    static std::span<float const> table_1d();
+
+private:
+    utils::RandomStream _random;
+    size_t              _next{0};
+    glm::vec2           _offset;
+    size_t              _next_1d{0};
+    float               _offset_1d;
+};
+
+// Points de Poisson-disk sur le tore [0, 1)² (algorithme de Bridson) : distance minimale min_distance entre deux points
+std::vector<glm::vec2> poisson_disk_points(float min_distance, utils::RandomStream& random);
+
+enum class PointPattern {
+    Uniform,
+    Halton,
+    Sobol,
+    R2,
+    BlueNoise,
+};
+
+// "uniform", "halton", "sobol", "r2", "blue-noise"
+std::optional<PointPattern> point_pattern_from_name(std::string_view name);
+
+// Une des sources ci-dessus, choisie à l'exécution
+class PointSource {
+public:
+    PointSource(PointPattern pattern, utils::RandomStream random);
+    void fill(std::span<float> u, std::span<float> v);
+    // Une seule coordonnée (émetteurs sur une ligne) : la première coordonnée des suites, la table 1D du bruit bleu
+    void fill(std::span<float> u);
+
+    PointPattern pattern() const { return _pattern; }
+
+private:
+    PointPattern                                                                            _pattern;
+    std::variant<UniformPoints, HaltonSequence, SobolSequence, R2Sequence, BlueNoisePoints> _source;
+};
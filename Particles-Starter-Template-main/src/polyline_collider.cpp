@@ -0,0 +1,99 @@
+#include "polyline_collider.hpp"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "utils.hpp"
+
+PolylineCollider::PolylineCollider(std::vector<glm::vec2> points, bool closed, float cell_size)
+    : _points{std::move(points)}
+    , _cell_size{cell_size}
+{
+    if (closed && !_points.empty())
+        _points.push_back(_points.front());
+
+    glm::vec2 min{std::numeric_limits<float>::max()};
+    glm::vec2 max{std::numeric_limits<float>::lowest()};
+    for (glm::vec2 point : _points)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    _min  = min;
+    _size = glm::max(glm::ivec2{glm::floor((max - min) / cell_size)} + 1, glm::ivec2{1});
+
+    // Chaque segment est rangé dans toutes les cases de sa boîte englobante (tri par comptage, en deux passes)
+    auto const for_each_cell = [&](size_t segment, auto&& callback) {
+        glm::ivec2 const first = glm::ivec2{glm::floor((glm::min(_points[segment], _points[segment + 1]) - _min) / _cell_size)};
+        glm::ivec2 const last  = glm::ivec2{glm::floor((glm::max(_points[segment], _points[segment + 1]) - _min) / _cell_size)};
+        for (int y = first.y; y <= last.y; ++y)
+            for (int x = first.x; x <= last.x; ++x)
+                callback(static_cast<size_t>(y) * static_cast<size_t>(_size.x) + static_cast<size_t>(x));
+    };
+
+    _cell_start.assign(static_cast<size_t>(_size.x) * static_cast<size_t>(_size.y) + 1, 0);
+    for (size_t segment = 0; segment + 1 < _points.size(); ++segment)
+        for_each_cell(segment, [&](size_t cell) { ++_cell_start[cell + 1]; });
+    for (size_t cell = 1; cell < _cell_start.size(); ++cell)
+        _cell_start[cell] += _cell_start[cell - 1];
+
+    _cell_segments.resize(_cell_start.back());
+    std::vector<uint32_t> cursor(_cell_start.begin(), _cell_start.end() - 1);
+    for (size_t segment = 0; segment + 1 < _points.size(); ++segment)
+        for_each_cell(segment, [&](size_t cell) { _cell_segments[cursor[cell]++] = static_cast<uint32_t>(segment); });
+}
+
+std::optional<PolylineHit> PolylineCollider::first_hit(glm::vec2 from, glm::vec2 to, std::optional<size_t> ignored_segment) const
+{
+    // Cases de la boîte englobante du déplacement, limitées à la grille
+    glm::ivec2 const first = glm::max(glm::ivec2{glm::floor((glm::min(from, to) - _min) / _cell_size)}, glm::ivec2{0});
+    glm::ivec2 const last  = glm::min(glm::ivec2{glm::floor((glm::max(from, to) - _min) / _cell_size)}, _size - 1);
+    if (first.x > last.x || first.y > last.y)
+        return std::nullopt;
+
+    glm::vec2 const motion        = to - from;
+    float const     motion_length = glm::dot(motion, motion);
+
+    std::optional<PolylineHit> best{};
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+        {
+            size_t const cell = static_cast<size_t>(y) * static_cast<size_t>(_size.x) + static_cast<size_t>(x);
+            // Un segment présent dans plusieurs cases est testé plusieurs fois : sans conséquence, on garde le plus proche
+            for (uint32_t k = _cell_start[cell]; k < _cell_start[cell + 1]; ++k)
+            {
+                size_t const segment = _cell_segments[k];
+                if (ignored_segment && segment == *ignored_segment)
+                    continue;
+                glm::vec2 const a = _points[segment];
+                glm::vec2 const b = _points[segment + 1];
+
+                std::optional<glm::vec2> const hit = utils::segment_intersection(from, to, a, b);
+                if (!hit)
+                    continue;
+                float const fraction = motion_length > 0.f ? glm::dot(*hit - from, motion) / motion_length : 0.f;
+                if (best && fraction >= best->fraction)
+                    continue;
+
+                glm::vec2 normal = glm::normalize(glm::vec2{a.y - b.y, b.x - a.x});
+                if (glm::dot(normal, motion) > 0.f)
+                    normal = -normal;
+                best = PolylineHit{.fraction = fraction, .point = *hit, .normal = normal, .segment = segment};
+            }
+        }
+    }
+    return best;
+}
+
+bool PolylineCollider::contains(glm::vec2 point) const
+{
+    bool inside = false;
+    for (size_t segment = 0; segment + 1 < _points.size(); ++segment)
+    {
+        glm::vec2 const a = _points[segment];
+        glm::vec2 const b = _points[segment + 1];
+        if ((a.y > point.y) != (b.y > point.y) && point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y))
+            inside = !inside;
+    }
+    return inside;
+}
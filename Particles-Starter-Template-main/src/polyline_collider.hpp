@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Premier point où un déplacement traverse la ligne
+struct PolylineHit {
+    float     fraction; // Position du point d'impact sur le déplacement : 0 au départ, 1 à l'arrivée
+    glm::vec2 point;
+    glm::vec2 normal;   // Normale unitaire du segment touché, du côté d'où vient le déplacement
+    size_t    segment;  // Le segment touché va de points()[segment] à points()[segment + 1]
+};
+
+// Ligne brisée fixe contre laquelle on teste des déplacements (détection continue des collisions).
+// Les segments sont rangés une fois pour toutes dans une grille uniforme qui couvre la ligne : un déplacement
+// court ne teste que les quelques segments des cases de sa boîte englobante, quel que soit le nombre de segments.
+class PolylineCollider {
+public:
+    // Si closed, le dernier point est relié au premier
+    PolylineCollider(std::vector<glm::vec2> points, bool closed, float cell_size);
+
+    // Premier impact du déplacement from -> to, en ignorant le segment ignored_segment
+    // (celui sur lequel on vient de rebondir). Les extrémités sont comprises.
+    std::optional<PolylineHit> first_hit(glm::vec2 from, glm::vec2 to, std::optional<size_t> ignored_segment = std::nullopt) const;
+    // Le point est-il à l'intérieur de la ligne fermée ? (parité des côtés traversés par une demi-droite horizontale ;
+    // O(n), pour quelques points seulement)
+    bool contains(glm::vec2 point) const;
+
+    std::span<glm::vec2 const> points() const { return _points; }
+    size_t                     segments_count() const { return _points.size() - 1; }
+
+private:
+    std::vector<glm::vec2> _points; // Fermée : le premier point est répété à la fin
+
+    glm::vec2  _min{};
+    float      _cell_size;
+    glm::ivec2 _size{}; // Nombre de cases dans chaque direction
+
+    std::vector<uint32_t> _cell_start{};    // Les segments de la case c sont _cell_segments[_cell_start[c], _cell_start[c + 1])
+    std::vector<uint32_t> _cell_segments{};
+};
@@ -0,0 +1,165 @@
+#include "polyline_renderer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+static auto make_polyline_shader() -> gl::Shader
+{
+    return gl::Shader{
+        gl::Shader_Descriptor{
+            .vertex = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec4 in_color;
+
+uniform float u_inverse_aspect_ratio;
+
+out vec4 v_color;
+
+void main()
+{
+    gl_Position = vec4(in_position * vec2(u_inverse_aspect_ratio, 1.), 0., 1.);
+    v_color = in_color;
+}
+)GLSL"}),
+            .fragment = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+in vec4 v_color;
+out vec4 out_color;
+
+void main()
+{
+    out_color = v_color;
+}
+)GLSL"}),
+        }
+    };
+}
+
+void tessellate_polyline(std::span<glm::vec2 const> points, std::span<float const> thickness, std::span<glm::vec4 const> colors, bool closed, float miter_limit, std::vector<PolylineVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    assert((thickness.size() == 1 || thickness.size() == points.size()) && (colors.size() == 1 || colors.size() == points.size()));
+
+    size_t count = points.size();
+    if (closed && count > 2 && points.front() == points.back())
+        --count;
+    if (count < 2)
+        return;
+
+    // Direction de chaque segment ; un segment de longueur nulle reprend la direction du précédent
+    thread_local std::vector<glm::vec2> directions{};
+    size_t const segments = closed ? count : count - 1;
+    directions.resize(segments);
+    glm::vec2 last_direction{1.f, 0.f};
+    for (size_t i = 0; i < segments; ++i)
+    {
+        glm::vec2 const delta  = points[(i + 1) % count] - points[i];
+        float const     length = glm::length(delta);
+        if (length > 1e-12f)
+            last_direction = delta / length;
+        directions[i] = last_direction;
+    }
+
+    auto const normal = [](glm::vec2 direction) { return glm::vec2{-direction.y, direction.x}; };
+
+    auto const first_vertex = static_cast<uint32_t>(vertices.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool const has_before = closed || i > 0;
+        bool const has_after  = closed || i + 1 < count;
+
+        glm::vec2 const normal_before = normal(directions[has_before ? (i + segments - 1) % segments : 0]);
+        glm::vec2 const normal_after  = normal(directions[has_after ? i : segments - 1]);
+
+        // Onglet : bissectrice des deux normales, allongée pour que les deux bords restent à la bonne épaisseur
+        glm::vec2       offset   = normal_after;
+        glm::vec2 const bisector = normal_before + normal_after;
+        if (has_before && has_after && glm::dot(bisector, bisector) > 1e-12f)
+        {
+            offset = glm::normalize(bisector);
+            offset /= std::max(glm::dot(offset, normal_after), 1.f / miter_limit);
+        }
+        offset *= 0.5f * thickness[thickness.size() == 1 ? 0 : i];
+
+        glm::vec4 const& color = colors[colors.size() == 1 ? 0 : i];
+        vertices.push_back({points[i] + offset, color});
+        vertices.push_back({points[i] - offset, color});
+    }
+
+    // Deux triangles par segment, entre les paires de sommets de ses deux extrémités
+    for (size_t i = 0; i < segments; ++i)
+    {
+        auto const a = first_vertex + static_cast<uint32_t>(2 * i);
+        auto const b = first_vertex + static_cast<uint32_t>(2 * ((i + 1) % count));
+        indices.insert(indices.end(), {a, a + 1, b, a + 1, b + 1, b});
+    }
+}
+
+// Envoie data dans buffer, en l'agrandissant par doublement si besoin.
+// Sinon le buffer est réalloué sans données (orphaning) pour ne pas attendre le GPU sur la frame précédente.
+static void upload(GLenum target, GLuint buffer, size_t& capacity, void const* data, size_t bytes)
+{
+    glBindBuffer(target, buffer);
+    if (bytes > capacity)
+        capacity = std::max(bytes, 2 * capacity);
+    glBufferData(target, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data);
+}
+
+PolylineRenderer::PolylineRenderer()
+    : _shader{make_polyline_shader()}
+{
+    glGenVertexArrays(1, &_vertex_array);
+    glBindVertexArray(_vertex_array);
+
+    glGenBuffers(1, &_vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _vertex_buffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(PolylineVertex), reinterpret_cast<void*>(offsetof(PolylineVertex, position))); // NOLINT(*reinterpret-cast, performance-no-int-to-ptr)
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PolylineVertex), reinterpret_cast<void*>(offsetof(PolylineVertex, color))); // NOLINT(*reinterpret-cast, performance-no-int-to-ptr)
+
+    // L'index buffer fait partie de l'état du vertex array
+    glGenBuffers(1, &_index_buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _index_buffer);
+
+    glBindVertexArray(0);
+}
+
+PolylineRenderer::~PolylineRenderer()
+{
+    glDeleteBuffers(1, &_index_buffer);
+    glDeleteBuffers(1, &_vertex_buffer);
+    glDeleteVertexArrays(1, &_vertex_array);
+}
+
+void PolylineRenderer::submit(std::span<glm::vec2 const> points, float thickness, glm::vec4 const& color, bool closed)
+{
+    tessellate_polyline(points, {&thickness, 1}, {&color, 1}, closed, miter_limit, _vertices, _indices);
+}
+
+void PolylineRenderer::submit(std::span<glm::vec2 const> points, std::span<float const> thickness, std::span<glm::vec4 const> colors, bool closed)
+{
+    assert(thickness.size() == points.size() && colors.size() == points.size());
+    tessellate_polyline(points, thickness, colors, closed, miter_limit, _vertices, _indices);
+}
+
+void PolylineRenderer::flush()
+{
+    if (_indices.empty())
+        return;
+
+    glBindVertexArray(_vertex_array);
+    upload(GL_ARRAY_BUFFER, _vertex_buffer, _vertex_buffer_capacity, _vertices.data(), _vertices.size() * sizeof(PolylineVertex));
+    upload(GL_ELEMENT_ARRAY_BUFFER, _index_buffer, _index_buffer_capacity, _indices.data(), _indices.size() * sizeof(uint32_t));
+
+    _shader.bind();
+    _shader.set_uniform("u_inverse_aspect_ratio", 1.f / gl::framebuffer_aspect_ratio());
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(_indices.size()), GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+
+    _vertices.clear();
+    _indices.clear();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "opengl-framework/opengl-framework.hpp"
+
+// Sommet d'une ligne découpée en triangles
+struct PolylineVertex {
+    glm::vec2 position;
+    glm::vec4 color;
+};
+
+// Découpe une ligne brisée en triangles (deux sommets par point, raccords en onglet) et les ajoute à vertices / indices.
+// thickness et colors ont soit un élément par point, soit un seul élément utilisé pour toute la ligne.
+// Si closed, le dernier point est relié au premier (un dernier point égal au premier est ignoré).
+// La pointe d'un onglet est coupée à miter_limit fois la demi-épaisseur (sinon les angles très aigus,
+// comme la pointe du cœur, donnent des pics démesurés).
+void tessellate_polyline(std::span<glm::vec2 const> points, std::span<float const> thickness, std::span<glm::vec4 const> colors, bool closed, float miter_limit, std::vector<PolylineVertex>& vertices, std::vector<uint32_t>& indices);
+
+// Dessine des lignes brisées épaisses, toutes celles d'une frame en un seul draw call.
+// submit() découpe chaque ligne en triangles sur le CPU avec tessellate_polyline(), flush() envoie tout au GPU et dessine. Les épaisseurs sont dans le même repère que les positions,
+// comme pour utils::draw_line(). Doit être construit après gl::init().
+class PolylineRenderer {
+public:
+    PolylineRenderer();
+    ~PolylineRenderer();
+    PolylineRenderer(PolylineRenderer const&)            = delete;
+    PolylineRenderer& operator=(PolylineRenderer const&) = delete;
+
+    // Épaisseur et couleur uniques pour toute la ligne
+    void submit(std::span<glm::vec2 const> points, float thickness, glm::vec4 const& color, bool closed = false);
+    // Épaisseur et couleur par point, interpolées le long des segments (mêmes tailles que points)
+    void submit(std::span<glm::vec2 const> points, std::span<float const> thickness, std::span<glm::vec4 const> colors, bool closed = false);
+
+    // Dessine toutes les lignes soumises depuis le dernier flush(), puis vide les listes
+    void flush();
+
+    float miter_limit = 4.f; // cf. tessellate_polyline()
+
+private:
+    std::vector<PolylineVertex> _vertices{};
+    std::vector<uint32_t>       _indices{};
+
+    gl::Shader _shader;
+    GLuint     _vertex_array{};
+    GLuint     _vertex_buffer{};
+    GLuint     _index_buffer{};
+    size_t     _vertex_buffer_capacity{0}; // En octets
+    size_t     _index_buffer_capacity{0};  // En octets
+};
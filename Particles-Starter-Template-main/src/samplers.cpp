@@ -0,0 +1,236 @@
+#include "samplers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+#include "simd.hpp"
+
+// Applique kernel(u, v) -> (x, y) par paquets de simd::width points. Les derniers points (moins d'un paquet)
+// passent par un paquet complété : un seul code pour tous les points, donc les mêmes résultats.
+template<typename Kernel>
+static void for_each_pack(std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y, Kernel&& kernel)
+{
+    size_t const count = u.size();
+    size_t       i     = 0;
+    for (; i + simd::width <= count; i += simd::width)
+    {
+        auto const [px, py] = kernel(simd::load(u.data() + i), simd::load(v.data() + i));
+        simd::store(x.data() + i, px);
+        simd::store(y.data() + i, py);
+    }
+    if (i == count)
+        return;
+
+    float pack_u[simd::width]{};
+    float pack_v[simd::width]{};
+    float pack_x[simd::width];
+    float pack_y[simd::width];
+    std::copy(u.begin() + i, u.end(), pack_u);
+    std::copy(v.begin() + i, v.end(), pack_v);
+    auto const [px, py] = kernel(simd::load(pack_u), simd::load(pack_v));
+    simd::store(pack_x, px);
+    simd::store(pack_y, py);
+    std::copy(pack_x, pack_x + (count - i), x.begin() + i);
+    std::copy(pack_y, pack_y + (count - i), y.begin() + i);
+}
+
+// sin et cos de 2π · turns pour turns ∈ [0, 1), sans appel à la libm : réduction à [0, π/2] puis séries
+// de Taylor (erreur < 1e-7)
+static void sincos_turns(simd::float_v turns, simd::float_v& sin, simd::float_v& cos)
+{
+    using simd::broadcast;
+    constexpr float pi = std::numbers::pi_v<float>;
+
+    // x = 2π · turns - π ∈ [-π, π) : sin(2π · turns) = -sin(x), cos(2π · turns) = -cos(x)
+    simd::float_v const x        = turns * broadcast(2.f * pi) - broadcast(pi);
+    simd::mask_v const  negative = x < broadcast(0.f);
+    simd::float_v const a        = simd::abs(x);
+    simd::mask_v const  folded   = a > broadcast(pi / 2.f);
+    simd::float_v const r        = simd::select(folded, broadcast(pi) - a, a); // ∈ [0, π/2]
+    simd::float_v const r2       = r * r;
+
+    simd::float_v sin_r = broadcast(-1.f / 39916800.f);
+    sin_r               = sin_r * r2 + broadcast(1.f / 362880.f);
+    sin_r               = sin_r * r2 - broadcast(1.f / 5040.f);
+    sin_r               = sin_r * r2 + broadcast(1.f / 120.f);
+    sin_r               = sin_r * r2 - broadcast(1.f / 6.f);
+    sin_r               = (sin_r * r2 + broadcast(1.f)) * r;
+
+    simd::float_v cos_r = broadcast(1.f / 479001600.f);
+    cos_r               = cos_r * r2 - broadcast(1.f / 3628800.f);
+    cos_r               = cos_r * r2 + broadcast(1.f / 40320.f);
+    cos_r               = cos_r * r2 - broadcast(1.f / 720.f);
+    cos_r               = cos_r * r2 + broadcast(1.f / 24.f);
+    cos_r               = cos_r * r2 - broadcast(1.f / 2.f);
+    cos_r               = cos_r * r2 + broadcast(1.f);
+
+    // sin(π - r) = sin(r), cos(π - r) = -cos(r), puis sin(-a) = -sin(a)
+    simd::float_v const sin_x = simd::select(negative, broadcast(0.f) - sin_r, sin_r);
+    simd::float_v const cos_x = simd::select(folded, broadcast(0.f) - cos_r, cos_r);
+    sin                       = broadcast(0.f) - sin_x;
+    cos                       = broadcast(0.f) - cos_x;
+}
+
+void warp(DiskShape const& disk, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y)
+{
+    for_each_pack(u, v, x, y, [&](simd::float_v u_pack, simd::float_v v_pack) {
+        simd::float_v sin, cos;
+        sincos_turns(u_pack, sin, cos);
+        simd::float_v const r = simd::sqrt(v_pack) * simd::broadcast(disk.radius);
+        return std::pair{simd::broadcast(disk.center.x) + r * cos, simd::broadcast(disk.center.y) + r * sin};
+    });
+}
+
+void warp(AnnulusShape const& annulus, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y)
+{
+    // Aire uniforme : r² uniforme entre inner² et outer²
+    float const inner2 = annulus.inner_radius * annulus.inner_radius;
+    float const outer2 = annulus.outer_radius * annulus.outer_radius;
+    for_each_pack(u, v, x, y, [&](simd::float_v u_pack, simd::float_v v_pack) {
+        simd::float_v sin, cos;
+        sincos_turns(u_pack, sin, cos);
+        simd::float_v const r = simd::sqrt(simd::broadcast(inner2) + v_pack * simd::broadcast(outer2 - inner2));
+        return std::pair{simd::broadcast(annulus.center.x) + r * cos, simd::broadcast(annulus.center.y) + r * sin};
+    });
+}
+
+void warp(RectangleShape const& rectangle, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y)
+{
+    glm::vec2 const size = rectangle.max - rectangle.min;
+    for_each_pack(u, v, x, y, [&](simd::float_v u_pack, simd::float_v v_pack) {
+        return std::pair{simd::broadcast(rectangle.min.x) + u_pack * simd::broadcast(size.x), simd::broadcast(rectangle.min.y) + v_pack * simd::broadcast(size.y)};
+    });
+}
+
+void warp(ParallelogramShape const& parallelogram, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y)
+{
+    using simd::broadcast;
+    for_each_pack(u, v, x, y, [&](simd::float_v u_pack, simd::float_v v_pack) {
+        return std::pair{
+            broadcast(parallelogram.origin.x) + u_pack * broadcast(parallelogram.edge_u.x) + v_pack * broadcast(parallelogram.edge_v.x),
+            broadcast(parallelogram.origin.y) + u_pack * broadcast(parallelogram.edge_u.y) + v_pack * broadcast(parallelogram.edge_v.y),
+        };
+    });
+}
+
+void warp(TriangleShape const& triangle, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y)
+{
+    // a + √u · ((1 - v) · (b - a) + v · (c - a)) : √u répartit les points uniformément entre le sommet a et le côté bc
+    using simd::broadcast;
+    glm::vec2 const ab = triangle.b - triangle.a;
+    glm::vec2 const ac = triangle.c - triangle.a;
+    for_each_pack(u, v, x, y, [&](simd::float_v u_pack, simd::float_v v_pack) {
+        simd::float_v const s = simd::sqrt(u_pack);
+        simd::float_v const w = broadcast(1.f) - v_pack;
+        return std::pair{
+            broadcast(triangle.a.x) + s * (w * broadcast(ab.x) + v_pack * broadcast(ac.x)),
+            broadcast(triangle.a.y) + s * (w * broadcast(ab.y) + v_pack * broadcast(ac.y)),
+        };
+    });
+}
+
+void warp(PolygonShape const& polygon, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y)
+{
+    polygon.warp(u, v, x, y);
+}
+
+static float cross(glm::vec2 a, glm::vec2 b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+// Le point p est-il dans le triangle abc (sens trigonométrique), bords compris ?
+static bool in_triangle(glm::vec2 p, glm::vec2 a, glm::vec2 b, glm::vec2 c)
+{
+    return cross(b - a, p - a) >= 0.f && cross(c - b, p - b) >= 0.f && cross(a - c, p - c) >= 0.f;
+}
+
+PolygonShape::PolygonShape(std::vector<glm::vec2> vertices)
+    : _vertices{std::move(vertices)}
+{
+    if (_vertices.size() < 3)
+        throw std::invalid_argument{"PolygonShape : il faut au moins 3 sommets"};
+
+    // Découpage en oreilles, O(n²) : fait une seule fois à la construction
+    std::vector<size_t> remaining(_vertices.size());
+    for (size_t i = 0; i < remaining.size(); ++i)
+        remaining[i] = i;
+
+    float signed_area = 0.f;
+    for (size_t i = 0, j = _vertices.size() - 1; i < _vertices.size(); j = i++)
+        signed_area += cross(_vertices[j], _vertices[i]);
+    if (signed_area < 0.f) // On travaille dans le sens trigonométrique
+        std::reverse(remaining.begin(), remaining.end());
+
+    size_t i = 0, attempts = 0;
+    while (remaining.size() > 3)
+    {
+        size_t const    n = remaining.size();
+        glm::vec2 const a = _vertices[remaining[(i + n - 1) % n]];
+        glm::vec2 const b = _vertices[remaining[i % n]];
+        glm::vec2 const c = _vertices[remaining[(i + 1) % n]];
+
+        float const turn = cross(b - a, c - b);
+        bool        ear  = turn > 0.f;        // Sommet convexe...
+        for (size_t k = 0; ear && k < n; ++k) // ...dont le triangle ne contient aucun autre sommet
+        {
+            glm::vec2 const p = _vertices[remaining[k]];
+            if (p != a && p != b && p != c && in_triangle(p, a, b, c))
+                ear = false;
+        }
+        // Un sommet aligné avec ses voisins est retiré sans triangle. Si aucun sommet n'est une oreille après un tour
+        // complet (contour qui se recoupe, arrondis), on coupe quand même : le découpage finit toujours.
+        if (ear || turn == 0.f || attempts >= n)
+        {
+            if (turn != 0.f)
+                _triangles.push_back({a, b, c});
+            remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(i % n));
+            attempts = 0;
+        }
+        else
+        {
+            ++i;
+            ++attempts;
+        }
+        i %= remaining.size();
+    }
+    if (remaining.size() == 3)
+        _triangles.push_back({_vertices[remaining[0]], _vertices[remaining[1]], _vertices[remaining[2]]});
+
+    _cumulative_area.resize(_triangles.size() + 1, 0.f);
+    for (size_t k = 0; k < _triangles.size(); ++k)
+    {
+        TriangleShape const& t = _triangles[k];
+        _area += 0.5f * std::abs(cross(t.b - t.a, t.c - t.a));
+        _cumulative_area[k + 1] = _area;
+    }
+    if (!(_area > 0.f))
+        throw std::invalid_argument{"PolygonShape : polygone d'aire nulle"};
+    for (float& cumulative : _cumulative_area)
+        cumulative /= _area;
+}
+
+void PolygonShape::warp(std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y) const
+{
+    // Pas de SIMD ici : chaque point lit un triangle différent
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        auto const   upper = std::upper_bound(_cumulative_area.begin() + 1, _cumulative_area.end() - 1, u[i]);
+        size_t const k     = static_cast<size_t>(upper - _cumulative_area.begin()) - 1;
+        float const  s     = std::sqrt(std::clamp((u[i] - _cumulative_area[k]) / (_cumulative_area[k + 1] - _cumulative_area[k]), 0.f, 1.f));
+        float const  w     = v[i];
+
+        TriangleShape const& t = _triangles[k];
+        glm::vec2 const      p = t.a + s * ((1.f - w) * (t.b - t.a) + w * (t.c - t.a));
+        x[i]                   = p.x;
+        y[i]                   = p.y;
+    }
+}
+
+void sample_disk_by_rejection(DiskShape const& disk, utils::RandomStream& random, std::span<float> x, std::span<float> y, AcceptanceStats& stats)
+{
+    RectangleShape const bounds{disk.center - disk.radius, disk.center + disk.radius};
+    float const          radius2 = disk.radius * disk.radius;
+    sample_by_rejection(bounds, [&](glm::vec2 p) { return glm::dot(p - disk.center, p - disk.center) <= radius2; }, random, x, y, stats);
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "glm/glm.hpp"
+#include "utils.hpp"
+
+// Échantillonnage uniforme de formes, par lots écrits directement dans des colonnes x / y (cf. ParticleStore::spawn_batch()).
+// Chaque forme a un warp() qui transforme des points (u, v) du carré unité [0, 1)² en points de la forme en gardant
+// l'uniformité : la source des (u, v) est interchangeable, sample() prend des tirages indépendants (RandomStream)
+// ou n'importe quelle source de point_sequences.hpp (suites à faible discrépance, bruit bleu).
+// Les warps traitent simd::width points à la fois (sauf celui du polygone) ; u, v peuvent être les mêmes tableaux que x, y.
+
+struct DiskShape {
+    glm::vec2 center{0.f};
+    float     radius = 1.f;
+};
+
+struct AnnulusShape {
+    glm::vec2 center{0.f};
+    float     inner_radius = 0.5f;
+    float     outer_radius = 1.f;
+};
+
+struct RectangleShape {
+    glm::vec2 min{0.f};
+    glm::vec2 max{1.f};
+};
+
+// origin + u · edge_u + v · edge_v
+struct ParallelogramShape {
+    glm::vec2 origin{0.f};
+    glm::vec2 edge_u{1.f, 0.f};
+    glm::vec2 edge_v{0.f, 1.f};
+};
+
+struct TriangleShape {
+    glm::vec2 a{0.f};
+    glm::vec2 b{1.f, 0.f};
+    glm::vec2 c{0.f, 1.f};
+};
+
+// Polygone simple (convexe ou non, sans trou), découpé une fois pour toutes en triangles (oreilles)
+class PolygonShape {
+public:
+    // Sommets dans l'ordre du contour, dans un sens ou dans l'autre. Lève std::invalid_argument s'il y en a moins
+    // de 3 ou si le polygone est d'aire nulle.
+    explicit PolygonShape(std::vector<glm::vec2> vertices);
+
+    std::span<glm::vec2 const>     vertices() const { return _vertices; }
+    std::span<TriangleShape const> triangles() const { return _triangles; }
+    float                          area() const { return _area; }
+
+    // u choisit le triangle (proportionnellement à son aire) puis est remis à l'échelle dans [0, 1)
+    void warp(std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y) const;
+
+private:
+    std::vector<glm::vec2>     _vertices;
+    std::vector<TriangleShape> _triangles{};
+    std::vector<float>         _cumulative_area{}; // _cumulative_area[k] : aire des triangles [0, k) / aire totale
+    float                      _area{0.f};
+};
+
+// Disque : rayon en racine carrée (sinon les points se concentrent au centre)
+void warp(DiskShape const& disk, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y);
+void warp(AnnulusShape const& annulus, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y);
+void warp(RectangleShape const& rectangle, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y);
+void warp(ParallelogramShape const& parallelogram, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y);
+void warp(TriangleShape const& triangle, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y);
+void warp(PolygonShape const& polygon, std::span<float const> u, std::span<float const> v, std::span<float> x, std::span<float> y);
+
+// x.size() points uniformes dans la forme
+template<typename Shape>
+void sample(Shape const& shape, utils::RandomStream& random, std::span<float> x, std::span<float> y)
+{
+    random.fill(x, 0.f, 1.f);
+    random.fill(y, 0.f, 1.f);
+    warp(shape, x, y, x, y);
+}
+
+// Même chose avec les (u, v) de source.fill(u, v) (cf. point_sequences.hpp) : une suite à faible discrépance
+// donne des points répartis régulièrement dans la forme
+template<typename Shape, typename Source>
+void sample(Shape const& shape, Source& source, std::span<float> x, std::span<float> y)
+{
+    source.fill(x, y);
+    warp(shape, x, y, x, y);
+}
+
+// Proportion de candidats acceptés par les méthodes de rejet, cumulée d'un appel à l'autre
+struct AcceptanceStats {
+    uint64_t proposed = 0;
+    uint64_t accepted = 0;
+
+    double rate() const { return proposed > 0 ? static_cast<double>(accepted) / static_cast<double>(proposed) : 1.; }
+};
+
+// Candidats tirés au plus par point demandé à sample_by_rejection()
+inline constexpr uint64_t max_candidates_per_point = 10'000;
+
+// Méthode de rejet : points uniformes dans bounds, gardés si inside(point). Marche pour n'importe quelle forme
+// qu'on sait tester, au prix de 1 / rate candidats par point. Les candidats sont tirés par lots dans la fin
+// de x / y, puis les acceptés sont tassés au début : aucune mémoire en plus. source : RandomStream ou source de
+// point_sequences.hpp (les points acceptés d'une suite régulière restent réguliers dans la forme).
+// Lève std::runtime_error au-delà de max_candidates_per_point candidats par point demandé (acceptation de
+// 1 / 10 000 ou moins) : sans cela, un inside() qui n'accepte jamais rien bouclerait sans fin.
+template<typename Inside, typename Source>
+void sample_by_rejection(RectangleShape const& bounds, Inside&& inside, Source& source, std::span<float> x, std::span<float> y, AcceptanceStats& stats)
+{
+    uint64_t const max_proposed = max_candidates_per_point * x.size();
+    uint64_t       proposed     = 0;
+    size_t         filled       = 0;
+    while (filled < x.size())
+    {
+        if (proposed >= max_proposed)
+        {
+            stats.proposed += proposed;
+            stats.accepted += filled;
+            throw std::runtime_error{"sample_by_rejection : la forme n'accepte presque aucun candidat"};
+        }
+        std::span<float> const candidates_x = x.subspan(filled);
+        std::span<float> const candidates_y = y.subspan(filled);
+        sample(bounds, source, candidates_x, candidates_y);
+        for (size_t k = 0; k < candidates_x.size(); ++k)
+        {
+            if (!inside(glm::vec2{candidates_x[k], candidates_y[k]}))
+                continue;
+            x[filled] = candidates_x[k];
+            y[filled] = candidates_y[k];
+            ++filled;
+        }
+        proposed += candidates_x.size();
+    }
+    stats.proposed += proposed;
+    stats.accepted += x.size();
+}
+
+// Disque par rejet dans le carré englobant (acceptation π / 4), comme randomCercleSampling dans saves/
+void sample_disk_by_rejection(DiskShape const& disk, utils::RandomStream& random, std::span<float> x, std::span<float> y, AcceptanceStats& stats);
@@ -0,0 +1,8 @@
+#pragma once
+#include "glm/glm.hpp"
+
+// Segment de droite, par exemple un mur d'un parcours d'obstacles ou le déplacement d'une particule pendant un pas
+struct Segment {
+    glm::vec2 start;
+    glm::vec2 end;
+};
@@ -0,0 +1,232 @@
+#include "segment_bvh.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include "thread_pool.hpp"
+#include "utils.hpp"
+
+static constexpr uint32_t leaf_size        = 4;
+static constexpr size_t   queries_per_task = 256;
+// La coupure par médiane divise par deux à chaque niveau : 32 niveaux suffisent pour 2^32 segments,
+// et la pile contient au plus un frère en attente par niveau
+static constexpr size_t   max_stack_size   = 64;
+
+void SegmentBvh::build(std::span<Segment const> segments)
+{
+    _ids.resize(segments.size());
+    std::iota(_ids.begin(), _ids.end(), 0u);
+    _centers.resize(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i)
+        _centers[i] = (segments[i].start + segments[i].end) * 0.5f;
+
+    _nodes.clear();
+    _nodes.reserve(2 * segments.size() / leaf_size + 1);
+    if (!segments.empty())
+        build_node(segments, 0, static_cast<uint32_t>(segments.size()));
+
+    // Une feuille lit des segments contigus en mémoire
+    _segments.resize(segments.size());
+    for (size_t k = 0; k < segments.size(); ++k)
+        _segments[k] = segments[_ids[k]];
+}
+
+uint32_t SegmentBvh::build_node(std::span<Segment const> segments, uint32_t begin, uint32_t end)
+{
+    uint32_t const index = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back({});
+
+    glm::vec2 min{std::numeric_limits<float>::max()};
+    glm::vec2 max{std::numeric_limits<float>::lowest()};
+    glm::vec2 center_min{std::numeric_limits<float>::max()};
+    glm::vec2 center_max{std::numeric_limits<float>::lowest()};
+    for (uint32_t k = begin; k < end; ++k)
+    {
+        Segment const& segment = segments[_ids[k]];
+        min                    = glm::min(min, glm::min(segment.start, segment.end));
+        max                    = glm::max(max, glm::max(segment.start, segment.end));
+        center_min             = glm::min(center_min, _centers[_ids[k]]);
+        center_max             = glm::max(center_max, _centers[_ids[k]]);
+    }
+
+    if (end - begin <= leaf_size)
+    {
+        _nodes[index] = Node{.min = min, .max = max, .first = begin, .count = end - begin};
+        return index;
+    }
+
+    // Médiane des centres sur l'axe le plus étendu : seul l'intervalle [begin, end) de _ids est permuté
+    int const      axis   = center_max.x - center_min.x >= center_max.y - center_min.y ? 0 : 1;
+    uint32_t const middle = begin + (end - begin) / 2;
+    std::nth_element(_ids.begin() + begin, _ids.begin() + middle, _ids.begin() + end, [&](uint32_t a, uint32_t b) {
+        return _centers[a][axis] < _centers[b][axis] || (_centers[a][axis] == _centers[b][axis] && a < b);
+    });
+
+    build_node(segments, begin, middle);
+    uint32_t const right = build_node(segments, middle, end);
+    _nodes[index]        = Node{.min = min, .max = max, .first = right, .count = 0};
+    return index;
+}
+
+template<typename Overlaps, typename Visit>
+void SegmentBvh::traverse(Overlaps&& overlaps, Visit&& visit) const
+{
+    if (_nodes.empty())
+        return;
+    std::array<uint32_t, max_stack_size> stack;
+    size_t                               stack_size = 0;
+    stack[stack_size++]                             = 0;
+    while (stack_size > 0)
+    {
+        uint32_t const index = stack[--stack_size];
+        Node const&    node  = _nodes[index];
+        if (!overlaps(node.min, node.max))
+            continue;
+        if (node.count > 0)
+        {
+            for (uint32_t k = node.first; k < node.first + node.count; ++k)
+                visit(k);
+        }
+        else
+        {
+            stack[stack_size++] = node.first;
+            stack[stack_size++] = index + 1;
+        }
+    }
+}
+
+// Le segment from -> to traverse-t-il la boîte [min, max] ? (méthode des dalles, bords compris)
+static bool segment_overlaps_box(Segment const& segment, glm::vec2 min, glm::vec2 max)
+{
+    glm::vec2 const direction = segment.end - segment.start;
+    float           t_enter   = 0.f;
+    float           t_exit    = 1.f;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        if (direction[axis] == 0.f)
+        {
+            if (segment.start[axis] < min[axis] || segment.start[axis] > max[axis])
+                return false;
+            continue;
+        }
+        float t0 = (min[axis] - segment.start[axis]) / direction[axis];
+        float t1 = (max[axis] - segment.start[axis]) / direction[axis];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        t_enter = std::max(t_enter, t0);
+        t_exit  = std::min(t_exit, t1);
+        if (t_enter > t_exit)
+            return false;
+    }
+    return true;
+}
+
+static bool circle_overlaps_box(Circle const& circle, glm::vec2 min, glm::vec2 max)
+{
+    glm::vec2 const offset = glm::clamp(circle.center, min, max) - circle.center;
+    return glm::dot(offset, offset) <= circle.radius * circle.radius;
+}
+
+static void sort_by_fraction(std::span<SegmentHit> hits)
+{
+    // L'indice départage les égalités : l'ordre ne dépend pas de la forme de l'arbre
+    std::sort(hits.begin(), hits.end(), [](SegmentHit const& a, SegmentHit const& b) {
+        return a.fraction < b.fraction || (a.fraction == b.fraction && a.segment < b.segment);
+    });
+}
+
+void SegmentBvh::intersect(Segment query, std::vector<SegmentHit>& hits) const
+{
+    size_t const    first_new = hits.size();
+    glm::vec2 const direction = query.end - query.start;
+    float const     length2   = glm::dot(direction, direction);
+    traverse(
+        [&](glm::vec2 min, glm::vec2 max) { return segment_overlaps_box(query, min, max); },
+        [&](uint32_t k) {
+            std::optional<glm::vec2> const point = utils::segment_intersection(query.start, query.end, _segments[k].start, _segments[k].end);
+            if (point)
+                hits.push_back({_ids[k], *point, length2 > 0.f ? glm::dot(*point - query.start, direction) / length2 : 0.f});
+        }
+    );
+    sort_by_fraction({hits.data() + first_new, hits.size() - first_new});
+}
+
+std::optional<SegmentHit> SegmentBvh::first_hit(Segment query) const
+{
+    glm::vec2 const direction = query.end - query.start;
+    float const     length2   = glm::dot(direction, direction);
+    std::optional<SegmentHit> best{};
+    traverse(
+        // Une fois un impact trouvé, seule la partie du segment avant lui peut encore donner mieux
+        [&](glm::vec2 min, glm::vec2 max) { return segment_overlaps_box(best ? Segment{query.start, best->point} : query, min, max); },
+        [&](uint32_t k) {
+            std::optional<glm::vec2> const point = utils::segment_intersection(query.start, query.end, _segments[k].start, _segments[k].end);
+            if (!point)
+                return;
+            float const fraction = length2 > 0.f ? glm::dot(*point - query.start, direction) / length2 : 0.f;
+            if (!best || fraction < best->fraction || (fraction == best->fraction && _ids[k] < best->segment))
+                best = SegmentHit{_ids[k], *point, fraction};
+        }
+    );
+    return best;
+}
+
+void SegmentBvh::intersect(Circle query, std::vector<SegmentHit>& hits) const
+{
+    size_t const first_new = hits.size();
+    traverse(
+        [&](glm::vec2 min, glm::vec2 max) { return circle_overlaps_box(query, min, max); },
+        [&](uint32_t k) {
+            Segment const&                 segment = _segments[k];
+            std::optional<glm::vec2> const point   = utils::segment_circle_intersection(segment.start, segment.end, query.center, query.radius);
+            if (!point)
+                return;
+            glm::vec2 const direction = segment.end - segment.start;
+            float const     length2   = glm::dot(direction, direction);
+            hits.push_back({_ids[k], *point, length2 > 0.f ? glm::dot(*point - segment.start, direction) / length2 : 0.f});
+        }
+    );
+    // Les fractions ne sont pas comparables d'un segment à l'autre : tri par indice de segment
+    std::sort(hits.begin() + static_cast<std::ptrdiff_t>(first_new), hits.end(), [](SegmentHit const& a, SegmentHit const& b) {
+        return a.segment < b.segment;
+    });
+}
+
+template<typename Query>
+void SegmentBvh::intersect_batch(std::span<Query const> queries, SegmentHitLists& hits) const
+{
+    size_t const chunks_count = (queries.size() + queries_per_task - 1) / queries_per_task;
+    hits._offsets.assign(queries.size() + 1, 0);
+    if (hits._chunk_hits.size() < chunks_count)
+        hits._chunk_hits.resize(chunks_count);
+
+    // Chaque tranche écrit ses impacts dans son propre tableau, dans l'ordre des requêtes
+    thread_pool().parallel_for(queries.size(), queries_per_task, [&](size_t begin, size_t end) {
+        std::vector<SegmentHit>& chunk_hits = hits._chunk_hits[begin / queries_per_task];
+        chunk_hits.clear();
+        for (size_t q = begin; q < end; ++q)
+        {
+            size_t const before = chunk_hits.size();
+            intersect(queries[q], chunk_hits);
+            hits._offsets[q + 1] = static_cast<uint32_t>(chunk_hits.size() - before);
+        }
+    });
+
+    // Les tableaux des tranches sont recollés dans l'ordre : même résultat quel que soit le nombre de threads
+    for (size_t q = 0; q < queries.size(); ++q)
+        hits._offsets[q + 1] += hits._offsets[q];
+    hits._hits.resize(hits._offsets.back());
+    auto out = hits._hits.begin();
+    for (size_t chunk = 0; chunk < chunks_count; ++chunk)
+        out = std::copy(hits._chunk_hits[chunk].begin(), hits._chunk_hits[chunk].end(), out);
+}
+
+void SegmentBvh::intersect(std::span<Segment const> queries, SegmentHitLists& hits) const
+{
+    intersect_batch(queries, hits);
+}
+
+void SegmentBvh::intersect(std::span<Circle const> queries, SegmentHitLists& hits) const
+{
+    intersect_batch(queries, hits);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+#include "segment.hpp"
+
+struct Circle {
+    glm::vec2 center;
+    float     radius;
+};
+
+struct SegmentHit {
+    uint32_t  segment;  // Indice du segment touché dans le tableau passé à SegmentBvh::build()
+    glm::vec2 point;
+    float     fraction; // Requête segment : position de l'impact sur la requête (0 au début, 1 à la fin).
+                        // Requête cercle : position de l'impact sur le segment touché.
+};
+
+// Résultat d'une requête par lots : liste des impacts de chaque requête, rangées bout à bout
+class SegmentHitLists {
+public:
+    size_t size() const { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+    // Impacts de la requête query, triés par fraction croissante
+    std::span<SegmentHit const> operator[](size_t query) const
+    {
+        return {_hits.data() + _offsets[query], _offsets[query + 1] - _offsets[query]};
+    }
+
+private:
+    friend class SegmentBvh;
+
+    std::vector<uint32_t>                _offsets{};    // Les impacts de la requête q sont _hits[_offsets[q], _offsets[q + 1])
+    std::vector<SegmentHit>              _hits{};
+    std::vector<std::vector<SegmentHit>> _chunk_hits{}; // Mémoire de travail : impacts de chaque tranche du parallel_for
+};
+
+// Hiérarchie de boîtes englobantes (BVH) sur un ensemble fixe de segments (les murs d'une scène).
+// Une requête ne descend que dans les boîtes qu'elle touche : O(log M) par requête au lieu de tester les M segments.
+// Les requêtes par lots sont réparties sur le pool de threads ; le résultat ne dépend pas du nombre de threads.
+class SegmentBvh {
+public:
+    // Construit l'arbre en O(M log M) (coupure au milieu de l'axe le plus long, par médiane)
+    void build(std::span<Segment const> segments);
+
+    size_t segments_count() const { return _segments.size(); }
+    size_t nodes_count() const { return _nodes.size(); }
+
+    // Tous les segments croisés par query (utils::segment_intersection), triés par fraction croissante, ajoutés à hits
+    void intersect(Segment query, std::vector<SegmentHit>& hits) const;
+    // Premier segment croisé par query en partant de query.start
+    std::optional<SegmentHit> first_hit(Segment query) const;
+    // Tous les segments qui coupent le bord du cercle (utils::segment_circle_intersection), ajoutés à hits
+    void intersect(Circle query, std::vector<SegmentHit>& hits) const;
+
+    // Versions par lots : hits[q] contient les impacts de queries[q]
+    void intersect(std::span<Segment const> queries, SegmentHitLists& hits) const;
+    void intersect(std::span<Circle const> queries, SegmentHitLists& hits) const;
+
+private:
+    struct Node {
+        glm::vec2 min;
+        glm::vec2 max;
+        uint32_t  first; // Feuille : premier segment dans _segments. Nœud interne : enfant de droite (celui de gauche suit le nœud).
+        uint32_t  count; // Nombre de segments de la feuille, 0 pour un nœud interne
+    };
+
+    // Nœud des segments _ids[begin, end) ; renvoie son indice
+    uint32_t build_node(std::span<Segment const> segments, uint32_t begin, uint32_t end);
+    // Appelle visit(k) pour chaque segment _segments[k] d'une feuille dont la boîte vérifie overlaps(min, max)
+    template<typename Overlaps, typename Visit>
+    void traverse(Overlaps&& overlaps, Visit&& visit) const;
+    template<typename Query>
+    void intersect_batch(std::span<Query const> queries, SegmentHitLists& hits) const;
+
+private:
+    std::vector<Node>      _nodes{};
+    std::vector<Segment>   _segments{}; // Rangés feuille par feuille
+    std::vector<uint32_t>  _ids{};      // _ids[k] : indice d'origine de _segments[k]
+    std::vector<glm::vec2> _centers{};  // Mémoire de travail de build() : centre de chaque segment, par indice d'origine
+};
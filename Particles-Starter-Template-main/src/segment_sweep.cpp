@@ -0,0 +1,354 @@
+#include "segment_sweep.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include "utils.hpp"
+
+// La droite de balayage est verticale et avance selon x ; à x égal, les points sont traités par y croissant
+static bool before(glm::vec2 a, glm::vec2 b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+static bool is_vertical(Segment const& s)
+{
+    return s.start.x == s.end.x;
+}
+
+// y de la droite d'un segment non vertical en x, en double : tous les segments sont comparés au même x, et un
+// segment presque vertical reste précis tant que x est dans son intervalle
+static double y_on(Segment const& s, float x)
+{
+    return s.start.y + (static_cast<double>(x) - s.start.x) * (static_cast<double>(s.end.y) - s.start.y) / (static_cast<double>(s.end.x) - s.start.x);
+}
+
+namespace {
+
+struct PointLess {
+    bool operator()(glm::vec2 a, glm::vec2 b) const { return before(a, b); }
+};
+
+// Segments qui commencent et finissent en un point du balayage, et voisins qui y changent d'ordre
+struct Event {
+    std::vector<uint32_t>                      starts;
+    std::vector<uint32_t>                      ends;
+    std::vector<std::pair<uint32_t, uint32_t>> crossings;
+};
+
+class Sweep {
+public:
+    explicit Sweep(std::span<Segment const> segments, std::vector<SegmentIntersection>& intersections);
+    void run();
+
+private:
+    // Ordre des segments le long de la droite de balayage en _sweep : par y, tous évalués au même x (_sweep.x), puis
+    // par pente (deux segments qui passent par un même point sont rangés dans leur ordre d'après ce point).
+    // Un segment vertical est coupé là où on en est sur la droite : il monte avec le point courant.
+    struct StatusLess {
+        Sweep const* sweep;
+        bool         operator()(uint32_t a, uint32_t b) const { return sweep->less(a, b, sweep->_sweep); }
+    };
+    using Status = std::set<uint32_t, StatusLess>;
+
+    double y_at(uint32_t segment, glm::vec2 sweep) const;
+    float  slope(uint32_t segment) const;
+    bool   less(uint32_t a, uint32_t b, glm::vec2 sweep) const;
+    bool   contains(uint32_t segment, glm::vec2 point) const;
+
+    // Premier point du balayage après point (ou point lui-même) où lower passe au-dessus de upper, d'après less() :
+    // le croisement arrondi est ajusté pour que l'ordre de _status y soit déjà celui d'après le croisement.
+    // std::nullopt si l'un des deux finit avant.
+    std::optional<glm::vec2> swap_point(uint32_t lower, uint32_t upper, glm::vec2 point) const;
+
+    void handle_event(glm::vec2 point, Event const& event);
+    // Si les deux segments (voisins sur la droite) se croisent, le croisement est rapporté, et devient un événement
+    // s'ils doivent changer d'ordre plus loin
+    void check_neighbours(Status::iterator lower, Status::iterator upper, glm::vec2 point);
+    // Vérifie le segment avec ses deux voisins sur la droite
+    void check_around(Status::iterator segment, glm::vec2 point);
+    void report(uint32_t a, uint32_t b);
+
+private:
+    std::span<Segment const>          _input;
+    std::vector<Segment>              _segments{}; // Orientés dans le sens du balayage ; le dernier sert de sonde
+    uint32_t                          _probe;
+    std::vector<SegmentIntersection>& _intersections;
+    float                             _tolerance{}; // Distance sous laquelle un point est considéré sur un segment (arrondis)
+
+    glm::vec2                             _sweep{};
+    std::map<glm::vec2, Event, PointLess> _events{};
+    Status                                _status;
+    std::vector<Status::iterator>         _handles{};  // Position de chaque segment dans _status (end() s'il n'y est pas)
+    std::unordered_set<uint64_t>          _reported{}; // Paires déjà testées
+    std::vector<uint32_t>                 _through{};  // Mémoire de travail de handle_event()
+    std::vector<uint32_t>                 _inserted{};
+    std::vector<uint32_t>                 _touched{};
+};
+
+Sweep::Sweep(std::span<Segment const> segments, std::vector<SegmentIntersection>& intersections)
+    : _input{segments}
+    , _probe{static_cast<uint32_t>(segments.size())}
+    , _intersections{intersections}
+    , _status{StatusLess{this}}
+{
+    float max_coordinate = 1.f;
+    _segments.reserve(segments.size() + 1);
+    for (uint32_t i = 0; i < segments.size(); ++i)
+    {
+        Segment segment = segments[i];
+        if (before(segment.end, segment.start))
+            std::swap(segment.start, segment.end);
+        _segments.push_back(segment);
+        max_coordinate = std::max({max_coordinate, std::abs(segment.start.x), std::abs(segment.start.y), std::abs(segment.end.x), std::abs(segment.end.y)});
+
+        // Un segment de longueur nulle ne croise rien pour utils::segment_intersection()
+        if (segment.start == segment.end)
+            continue;
+        _events[segment.start].starts.push_back(i);
+        _events[segment.end].ends.push_back(i);
+    }
+    _segments.push_back({});
+    _handles.resize(segments.size(), _status.end());
+    _tolerance = 1e-5f * max_coordinate;
+}
+
+void Sweep::run()
+{
+    // Les événements ajoutés pendant le traitement d'un événement sont toujours après lui : on prend toujours le premier
+    while (!_events.empty())
+    {
+        auto const      first = _events.begin();
+        glm::vec2 const point = first->first;
+        Event const     event = std::move(first->second);
+        _events.erase(first);
+        handle_event(point, event);
+    }
+}
+
+double Sweep::y_at(uint32_t segment, glm::vec2 sweep) const
+{
+    Segment const& s = _segments[segment];
+    if (is_vertical(s))
+        return std::clamp(sweep.y, s.start.y, s.end.y);
+    return y_on(s, sweep.x);
+}
+
+float Sweep::slope(uint32_t segment) const
+{
+    Segment const& s = _segments[segment];
+    if (segment == _probe)
+        return -std::numeric_limits<float>::infinity(); // La sonde passe avant tous les segments du point
+    if (is_vertical(s))
+        return std::numeric_limits<float>::infinity();
+    return (s.end.y - s.start.y) / (s.end.x - s.start.x);
+}
+
+bool Sweep::less(uint32_t a, uint32_t b, glm::vec2 sweep) const
+{
+    double const ya = y_at(a, sweep);
+    double const yb = y_at(b, sweep);
+    if (ya != yb)
+        return ya < yb;
+    float const slope_a = slope(a);
+    float const slope_b = slope(b);
+    if (slope_a != slope_b)
+        return slope_a < slope_b;
+    return a < b;
+}
+
+bool Sweep::contains(uint32_t segment, glm::vec2 point) const
+{
+    Segment const&  s         = _segments[segment];
+    glm::vec2 const direction = s.end - s.start;
+    float const     t         = std::clamp(glm::dot(point - s.start, direction) / glm::dot(direction, direction), 0.f, 1.f);
+    return glm::distance(s.start + t * direction, point) <= _tolerance;
+}
+
+std::optional<glm::vec2> Sweep::swap_point(uint32_t lower, uint32_t upper, glm::vec2 point) const
+{
+    Segment const&  a         = _segments[lower];
+    Segment const&  b         = _segments[upper];
+    glm::vec2 const first_end = before(a.end, b.end) ? a.end : b.end;
+    auto const      swapped   = [&](glm::vec2 sweep) { return less(upper, lower, sweep); };
+
+    if (is_vertical(a) || is_vertical(b))
+    {
+        // Le segment vertical monte avec le point courant, dans sa colonne : premier y flottant où il a dépassé
+        // l'autre segment
+        Segment const& other = is_vertical(a) ? b : a;
+        float const    x     = is_vertical(a) ? a.start.x : b.start.x;
+        double const   y     = y_on(other, x);
+        glm::vec2      at{x, static_cast<float>(y)};
+        if (at.y < y)
+            at.y = std::nextafter(at.y, std::numeric_limits<float>::infinity());
+        if (before(at, point))
+            at = point;
+        if (before(first_end, at) || !swapped(at))
+            return std::nullopt;
+        return at;
+    }
+
+    // Sinon, premier x flottant où l'ordre calculé par y_at() s'est inversé : à ce x, les deux segments sont déjà dans
+    // leur ordre d'après le croisement, qui est traité avant tout autre événement de cette colonne
+    auto const column = [](float x) { return glm::vec2{x, -std::numeric_limits<float>::infinity()}; };
+    if (swapped(column(point.x)))
+        return point; // Déjà inversés dans la colonne courante : on les remet en ordre au point courant
+    if (!swapped(column(first_end.x)))
+        return std::nullopt;
+
+    // Recherche par dichotomie entre une colonne où l'ordre n'a pas changé (lo) et une où il a changé (hi), en partant
+    // d'un encadrement serré autour du croisement arrondi
+    float                          lo       = point.x;
+    float                          hi       = first_end.x;
+    std::optional<glm::vec2> const crossing = utils::segment_intersection(a.start, a.end, b.start, b.end);
+    if (crossing && lo < crossing->x && crossing->x < hi)
+    {
+        float const guess = crossing->x;
+        bool const  after = swapped(column(guess));
+        for (float delta = _tolerance * 1e-2f;; delta *= 4.f)
+        {
+            float const other = after ? guess - delta : guess + delta;
+            if (other <= lo || other >= hi)
+                break;
+            if (swapped(column(other)) != after)
+            {
+                lo = after ? other : guess;
+                hi = after ? guess : other;
+                break;
+            }
+        }
+        (after ? hi : lo) = std::clamp(guess, lo, hi);
+    }
+    for (;;)
+    {
+        float const middle = lo + 0.5f * (hi - lo);
+        if (middle <= lo || middle >= hi)
+            break;
+        (swapped(column(middle)) ? hi : lo) = middle;
+    }
+    return column(hi);
+}
+
+void Sweep::report(uint32_t a, uint32_t b)
+{
+    if (a > b)
+        std::swap(a, b);
+    if (!_reported.insert((static_cast<uint64_t>(a) << 32) | b).second)
+        return;
+    // Calcul refait sur les segments d'entrée, dans leur sens d'origine : même résultat que le test de toutes les paires
+    std::optional<glm::vec2> const point = utils::segment_intersection(_input[a].start, _input[a].end, _input[b].start, _input[b].end);
+    if (point)
+        _intersections.push_back({a, b, *point});
+}
+
+void Sweep::check_neighbours(Status::iterator lower, Status::iterator upper, glm::vec2 point)
+{
+    Segment const& a = _segments[*lower];
+    Segment const& b = _segments[*upper];
+    if (!utils::segment_intersection(a.start, a.end, b.start, b.end))
+        return;
+    // La paire est rapportée dès maintenant ; si elle change d'ordre plus loin, elle y sera remise en ordre et chacun
+    // des deux segments découvrira ses nouveaux voisins
+    report(*lower, *upper);
+    if (std::optional<glm::vec2> const swap = swap_point(*lower, *upper, point))
+        _events[*swap].crossings.emplace_back(*lower, *upper);
+}
+
+void Sweep::check_around(Status::iterator segment, glm::vec2 point)
+{
+    if (segment != _status.begin())
+        check_neighbours(std::prev(segment), segment, point);
+    if (std::next(segment) != _status.end())
+        check_neighbours(segment, std::next(segment), point);
+}
+
+void Sweep::handle_event(glm::vec2 point, Event const& event)
+{
+    _sweep = point;
+
+    // Toutes les paires qui se touchent ici (en pratique deux ou trois segments) : ceux qui commencent ou finissent au
+    // point, et ceux de la droite de balayage qui y passent à l'arrondi près, côte à côte autour de la sonde
+    _segments[_probe] = Segment{point, point};
+    auto first        = _status.lower_bound(_probe);
+    auto last         = first;
+    while (first != _status.begin() && contains(*std::prev(first), point))
+        --first;
+    while (last != _status.end() && contains(*last, point))
+        ++last;
+    _through.assign(first, last);
+    _through.insert(_through.end(), event.ends.begin(), event.ends.end());
+    _through.insert(_through.end(), event.starts.begin(), event.starts.end());
+    for (size_t i = 0; i < _through.size(); ++i)
+        for (size_t j = i + 1; j < _through.size(); ++j)
+            if (_through[i] != _through[j])
+                report(_through[i], _through[j]);
+
+    // Ceux qui finissent sont retirés ; ceux qui changent d'ordre ici sont retirés puis remis à leur place, donnée par
+    // leur y en ce point comme pour ceux qui commencent. Les voisins de chaque segment retiré en ont de nouveaux.
+    _inserted.clear();
+    _touched.clear();
+    auto const remove = [&](uint32_t segment) {
+        auto const handle = _handles[segment];
+        if (handle == _status.end())
+            return false;
+        if (handle != _status.begin())
+            _touched.push_back(*std::prev(handle));
+        if (std::next(handle) != _status.end())
+            _touched.push_back(*std::next(handle));
+        _status.erase(handle);
+        _handles[segment] = _status.end();
+        return true;
+    };
+    for (uint32_t segment : event.ends)
+        remove(segment);
+    for (auto [lower, upper] : event.crossings)
+    {
+        for (uint32_t segment : {lower, upper})
+        {
+            if (remove(segment))
+                _inserted.push_back(segment);
+        }
+    }
+    _inserted.insert(_inserted.end(), event.starts.begin(), event.starts.end());
+    for (uint32_t segment : _inserted)
+        _handles[segment] = _status.insert(segment).first;
+
+    // Un segment presque vertical peut passer plusieurs segments dans une même colonne : il les a tous croisés, pas
+    // seulement celui avec qui il a changé d'ordre
+    for (auto [lower, upper] : event.crossings)
+    {
+        if (_handles[lower] == _status.end() || _handles[upper] == _status.end())
+            continue;
+        auto const order = _status.key_comp();
+        auto const first = order(lower, upper) ? _handles[lower] : _handles[upper];
+        auto const last  = order(lower, upper) ? _handles[upper] : _handles[lower];
+        for (auto between = std::next(first); between != last; ++between)
+        {
+            report(lower, *between);
+            report(upper, *between);
+        }
+    }
+
+    // Deux segments qui étaient séparés par un segment retiré deviennent voisins, et les segments remis ont de
+    // nouveaux voisins
+    for (uint32_t segment : _touched)
+    {
+        if (_handles[segment] != _status.end())
+            check_around(_handles[segment], point);
+    }
+    for (uint32_t segment : _inserted)
+        check_around(_handles[segment], point);
+}
+
+} // namespace
+
+void find_segment_intersections(std::span<Segment const> segments, std::vector<SegmentIntersection>& intersections)
+{
+    Sweep sweep{segments, intersections};
+    sweep.run();
+}
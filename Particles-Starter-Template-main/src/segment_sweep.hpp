@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+#include "segment.hpp"
+
+// Croisement entre deux segments d'un ensemble (first < second, indices dans le tableau d'entrée)
+struct SegmentIntersection {
+    uint32_t  first;
+    uint32_t  second;
+    glm::vec2 point;
+};
+
+// Tous les croisements entre les segments, par balayage (Bentley–Ottmann) : O((n + k) log n) pour k croisements,
+// au lieu de tester les n² paires. Une paire est rapportée exactement quand utils::segment_intersection() la
+// rapporterait (mêmes calculs : extrémités comprises, segments parallèles ou colinéaires ignorés), au point qu'elle renvoie.
+// Les croisements sont ajoutés à intersections dans l'ordre du balayage (x croissant).
+void find_segment_intersections(std::span<Segment const> segments, std::vector<SegmentIntersection>& intersections);
@@ -0,0 +1,166 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+// Petite surcouche au-dessus des intrinsics : float_v contient simd::width floats,
+// et la largeur est choisie à la compilation selon le jeu d'instructions disponible
+// (AVX-512 : 16, AVX/AVX2 : 8, SSE2 : 4, sinon 1).
+// Les comparaisons donnent un mask_v, utilisé par select() pour choisir voie par voie sans branchement.
+namespace simd {
+
+#if defined(__AVX512F__)
+
+inline constexpr size_t width = 16;
+
+struct float_v {
+    __m512 v;
+};
+
+inline float_v load(float const* p) { return {_mm512_loadu_ps(p)}; }
+inline void    store(float* p, float_v a) { _mm512_storeu_ps(p, a.v); }
+inline float_v broadcast(float x) { return {_mm512_set1_ps(x)}; }
+inline float_v operator+(float_v a, float_v b) { return {_mm512_add_ps(a.v, b.v)}; }
+inline float_v operator-(float_v a, float_v b) { return {_mm512_sub_ps(a.v, b.v)}; }
+inline float_v operator*(float_v a, float_v b) { return {_mm512_mul_ps(a.v, b.v)}; }
+inline float_v operator/(float_v a, float_v b) { return {_mm512_div_ps(a.v, b.v)}; }
+inline float_v min(float_v a, float_v b) { return {_mm512_min_ps(a.v, b.v)}; }
+inline float_v max(float_v a, float_v b) { return {_mm512_max_ps(a.v, b.v)}; }
+inline float_v sqrt(float_v a) { return {_mm512_sqrt_ps(a.v)}; }
+
+struct mask_v {
+    __mmask16 m;
+};
+
+inline mask_v  operator<(float_v a, float_v b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+inline mask_v  operator<=(float_v a, float_v b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)}; }
+inline mask_v  operator&(mask_v a, mask_v b) { return {static_cast<__mmask16>(a.m & b.m)}; }
+inline mask_v  operator|(mask_v a, mask_v b) { return {static_cast<__mmask16>(a.m | b.m)}; }
+inline mask_v  operator!(mask_v a) { return {static_cast<__mmask16>(~a.m)}; }
+inline bool    all(mask_v a) { return a.m == 0xFFFF; }
+inline bool    any(mask_v a) { return a.m != 0; }
+inline float_v select(mask_v m, float_v if_true, float_v if_false) { return {_mm512_mask_blend_ps(m.m, if_false.v, if_true.v)}; }
+
+#elif defined(__AVX__)
+
+inline constexpr size_t width = 8;
+
+struct float_v {
+    __m256 v;
+};
+
+inline float_v load(float const* p) { return {_mm256_loadu_ps(p)}; }
+inline void    store(float* p, float_v a) { _mm256_storeu_ps(p, a.v); }
+inline float_v broadcast(float x) { return {_mm256_set1_ps(x)}; }
+inline float_v operator+(float_v a, float_v b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline float_v operator-(float_v a, float_v b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline float_v operator*(float_v a, float_v b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline float_v operator/(float_v a, float_v b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline float_v min(float_v a, float_v b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline float_v max(float_v a, float_v b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline float_v sqrt(float_v a) { return {_mm256_sqrt_ps(a.v)}; }
+
+struct mask_v {
+    __m256 m;
+};
+
+inline mask_v  operator<(float_v a, float_v b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline mask_v  operator<=(float_v a, float_v b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline mask_v  operator&(mask_v a, mask_v b) { return {_mm256_and_ps(a.m, b.m)}; }
+inline mask_v  operator|(mask_v a, mask_v b) { return {_mm256_or_ps(a.m, b.m)}; }
+inline mask_v  operator!(mask_v a) { return {_mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+inline bool    all(mask_v a) { return _mm256_movemask_ps(a.m) == 0xFF; }
+inline bool    any(mask_v a) { return _mm256_movemask_ps(a.m) != 0; }
+inline float_v select(mask_v m, float_v if_true, float_v if_false) { return {_mm256_blendv_ps(if_false.v, if_true.v, m.m)}; }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+inline constexpr size_t width = 4;
+
+struct float_v {
+    __m128 v;
+};
+
+inline float_v load(float const* p) { return {_mm_loadu_ps(p)}; }
+inline void    store(float* p, float_v a) { _mm_storeu_ps(p, a.v); }
+inline float_v broadcast(float x) { return {_mm_set1_ps(x)}; }
+inline float_v operator+(float_v a, float_v b) { return {_mm_add_ps(a.v, b.v)}; }
+inline float_v operator-(float_v a, float_v b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline float_v operator*(float_v a, float_v b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline float_v operator/(float_v a, float_v b) { return {_mm_div_ps(a.v, b.v)}; }
+inline float_v min(float_v a, float_v b) { return {_mm_min_ps(a.v, b.v)}; }
+inline float_v max(float_v a, float_v b) { return {_mm_max_ps(a.v, b.v)}; }
+inline float_v sqrt(float_v a) { return {_mm_sqrt_ps(a.v)}; }
+
+struct mask_v {
+    __m128 m;
+};
+
+inline mask_v  operator<(float_v a, float_v b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline mask_v  operator<=(float_v a, float_v b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline mask_v  operator&(mask_v a, mask_v b) { return {_mm_and_ps(a.m, b.m)}; }
+inline mask_v  operator|(mask_v a, mask_v b) { return {_mm_or_ps(a.m, b.m)}; }
+inline mask_v  operator!(mask_v a) { return {_mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+inline bool    all(mask_v a) { return _mm_movemask_ps(a.m) == 0xF; }
+inline bool    any(mask_v a) { return _mm_movemask_ps(a.m) != 0; }
+inline float_v select(mask_v m, float_v if_true, float_v if_false) { return {_mm_or_ps(_mm_and_ps(m.m, if_true.v), _mm_andnot_ps(m.m, if_false.v))}; }
+
+#else
+
+inline constexpr size_t width = 1;
+
+struct float_v {
+    float v;
+};
+
+inline float_v load(float const* p) { return {*p}; }
+inline void    store(float* p, float_v a) { *p = a.v; }
+inline float_v broadcast(float x) { return {x}; }
+inline float_v operator+(float_v a, float_v b) { return {a.v + b.v}; }
+inline float_v operator-(float_v a, float_v b) { return {a.v - b.v}; }
+inline float_v operator*(float_v a, float_v b) { return {a.v * b.v}; }
+inline float_v operator/(float_v a, float_v b) { return {a.v / b.v}; }
+inline float_v min(float_v a, float_v b) { return {a.v < b.v ? a.v : b.v}; }
+inline float_v max(float_v a, float_v b) { return {a.v > b.v ? a.v : b.v}; }
+inline float_v sqrt(float_v a) { return {std::sqrt(a.v)}; }
+
+struct mask_v {
+    bool m;
+};
+
+inline mask_v  operator<(float_v a, float_v b) { return {a.v < b.v}; }
+inline mask_v  operator<=(float_v a, float_v b) { return {a.v <= b.v}; }
+inline mask_v  operator&(mask_v a, mask_v b) { return {a.m && b.m}; }
+inline mask_v  operator|(mask_v a, mask_v b) { return {a.m || b.m}; }
+inline mask_v  operator!(mask_v a) { return {!a.m}; }
+inline bool    all(mask_v a) { return a.m; }
+inline bool    any(mask_v a) { return a.m; }
+inline float_v select(mask_v m, float_v if_true, float_v if_false) { return m.m ? if_true : if_false; }
+
+#endif
+
+inline mask_v   operator>(float_v a, float_v b) { return b < a; }
+inline mask_v   operator>=(float_v a, float_v b) { return b <= a; }
+inline mask_v&  operator|=(mask_v& a, mask_v b) { return a = a | b; }
+inline float_v  abs(float_v a) { return max(a, broadcast(0.f) - a); }
+inline float_v& operator+=(float_v& a, float_v b) { return a = a + b; }
+inline float_v& operator-=(float_v& a, float_v b) { return a = a - b; }
+inline float_v& operator*=(float_v& a, float_v b) { return a = a * b; }
+
+// Nom du jeu d'instructions utilisé, pour les logs
+inline constexpr char const* instruction_set()
+{
+    if constexpr (width == 16)
+        return "AVX-512";
+    else if constexpr (width == 8)
+        return "AVX";
+    else if constexpr (width == 4)
+        return "SSE2";
+    else
+        return "scalaire";
+}
+
+} // namespace simd
@@ -0,0 +1,223 @@
+#include "simulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include "forces.hpp"
+#include "heart.hpp"
+#include "integrate.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+
+static constexpr size_t particles_per_task = 1024;
+
+HeartDistanceField Simulation::make_heart_field() {
+    return HeartDistanceField{glm::vec2{-2.5f, -1.5f}, glm::vec2{2.5f, 1.5f}, 0.01f};
+}
+
+PolylineCollider Simulation::make_heart_collider() {
+    static constexpr int samples = 1024;
+    std::vector<glm::vec2> points(samples);
+    for (int i = 0; i < samples; ++i)
+        points[i] = heart_curve(static_cast<float>(i) / samples);
+    return PolylineCollider{std::move(points), true, 0.05f};
+}
+
+ArcLengthCurve Simulation::make_heart_outline() {
+    return ArcLengthCurve{heart_curve};
+}
+
+// Numéros des flux de la simulation, dérivés de la graine
+static constexpr uint64_t rain_stream_id        = 0;
+static constexpr uint64_t rain_points_stream_id = 1;
+
+Simulation::Simulation(size_t max_particles, uint64_t seed)
+    : particles{max_particles}
+    , rain_random{utils::RandomStream{seed}.split(rain_stream_id)}
+    , heart_distances(max_particles)
+{}
+
+void Simulation::set_rain_pattern(PointPattern pattern) {
+    if (pattern == PointPattern::Uniform)
+        rain_points.reset();
+    else
+        rain_points.emplace(pattern, rain_random.split(rain_points_stream_id));
+}
+
+void Simulation::spawn_rain_particles(float aspect_ratio) {
+    // Toutes les abscisses d'un coup, tirées directement dans la colonne des positions
+    particles.spawn_batch(static_cast<size_t>(std::max(rain_per_step, 0)), [&](std::span<float> x, std::span<float> y) {
+        if (rain_points) {
+            // La pluie part d'une ligne : seulement u
+            rain_points->fill(x);
+            for (float& position : x)
+                position = aspect_ratio * (2.f * position - 1.f);
+        } else {
+            rain_random.fill(x, -aspect_ratio, aspect_ratio);
+        }
+        std::fill(y.begin(), y.end(), 1.1f);
+    });
+}
+
+void Simulation::spawn_heart_emitter_particles(float dt) {
+    if (heart_emitter_per_step <= 0)
+        return;
+    // Arc parcouru pendant le pas découpé en parts égales, une particule au milieu de chaque part : l'espacement
+    // ne dépend pas de la forme du cœur (un t uniforme serrerait les particules aux deux pointes)
+    // Les particules partent un peu à l'extérieur de la courbe : le polygone des collisions s'en écarte jusqu'à ~1e-5,
+    // et une particule qui part de l'intérieur du polygone y reste enfermée. Le long de la normale, sauf dans la fente
+    // du creux en haut, où les deux bords sont presque confondus : la normale traverse l'autre bord, on remonte la fente.
+    static constexpr float offset = 1e-3f;
+    glm::vec2 const notch_tangent = heart_tangent(0.f);
+    glm::vec2 const notch_normal{-notch_tangent.y, notch_tangent.x};
+
+    float const start = heart_emitter_position;
+    float const arc = heart_emitter_speed * dt;
+    float const count = static_cast<float>(heart_emitter_per_step);
+    particles.spawn_batch(static_cast<size_t>(heart_emitter_per_step), [&](std::span<float> x, std::span<float> y) {
+        for (size_t k = 0; k < x.size(); ++k) {
+            float const t = heart_outline.t_at_length(start + arc * (static_cast<float>(k) + 0.5f) / count);
+            glm::vec2 const tangent = heart_tangent(t);
+            glm::vec2 position = heart_curve(t) + offset * glm::vec2(-tangent.y, tangent.x);
+            if (heart_collider.contains(position))
+                position = heart_curve(t) + offset * notch_normal;
+            x[k] = position.x;
+            y[k] = position.y;
+        }
+    });
+    heart_emitter_position = std::fmod(start + arc, heart_outline.length());
+}
+
+ClosestPoint Simulation::closest_point_on_heart_cached(size_t i) {
+    glm::vec2 position = particles.position(i);
+    glm::vec2 anchor{particles.closest_anchor_x[i], particles.closest_anchor_y[i]};
+
+    std::optional<ClosestPoint> closest;
+    if (!std::isnan(particles.closest_t[i]) && glm::distance(position, anchor) < warm_start_radius)
+        closest = closest_point_on_heart_near(position, particles.closest_t[i]);
+
+    if (!closest) { // Premier pas de la particule, ou elle a trop bougé : recherche complète
+        closest = closest_point_on_heart(position);
+        particles.closest_anchor_x[i] = position.x;
+        particles.closest_anchor_y[i] = position.y;
+    }
+    particles.closest_t[i] = closest->t;
+    return *closest;
+}
+
+CurveDistance Simulation::distance_to_heart(size_t i) {
+    glm::vec2 position = particles.position(i);
+    if (use_distance_field && heart_field && heart_field->contains(position)) {
+        HeartFieldSample heart = heart_field->sample(position);
+        return {std::abs(heart.signed_distance), heart.normal};
+    }
+    ClosestPoint closest = closest_point_on_heart_cached(i);
+    glm::vec2 tangent = heart_tangent(closest.t);
+    return {closest.distance, glm::vec2(-tangent.y, tangent.x)};
+}
+
+void Simulation::update_heart_distances(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+        heart_distances[i] = distance_to_heart(i);
+}
+
+void Simulation::compute_forces(size_t begin, size_t end) {
+    update_heart_distances(begin, end);
+    auto const heart = CurveRepulsion{[this](ParticleStore const&, size_t i) { return heart_distances[i]; }, 5.f, 10.f};
+    auto const gravity = Gravity{glm::vec2(0.f, -0.4f)};
+
+    // Une seule boucle sur les particules pour toutes les forces. La composition est choisie ici, une fois par
+    // tranche, plutôt que de tester dans la boucle si l'attraction est active.
+    if (particle_attraction != 0.f)
+        make_force_pipeline(heart, gravity, ParticleAttraction{&attraction_tree, particle_attraction}).apply(particles, begin, end);
+    else
+        make_force_pipeline(heart, gravity).apply(particles, begin, end);
+}
+
+void Simulation::collide_with_heart_polyline(size_t begin, size_t end, float dt) {
+    // Distance gardée entre la particule et le segment touché, pour qu'elle reste du côté d'où elle vient. On recule
+    // le long du déplacement déjà fait, qui ne traverse rien : le long de la normale, on pourrait traverser l'autre
+    // bord du creux en haut du cœur, où les deux côtés sont presque parallèles.
+    static constexpr float skin = 1e-4f;
+    // Au-delà, la particule s'arrête au point d'impact (coincée dans un creux du polygone)
+    static constexpr int max_bounces = 2;
+
+    for (size_t i = begin; i < end; ++i) {
+        glm::vec2 from{particles.previous_position_x[i], particles.previous_position_y[i]};
+        glm::vec2 to = particles.position(i);
+        glm::vec2 velocity = particles.velocity(i);
+
+        std::optional<size_t> last_segment{};
+        float remaining = 1.f; // Part du pas qu'il reste à parcourir depuis from
+        for (int bounce = 0; bounce <= max_bounces; ++bounce) {
+            std::optional<PolylineHit> hit = heart_collider.first_hit(from, to, last_segment);
+            if (!hit)
+                break;
+            float const length = glm::distance(from, to);
+            glm::vec2 const contact = glm::mix(from, to, std::max(hit->fraction - skin / length, 0.f));
+            if (bounce == max_bounces) {
+                to = contact;
+                break;
+            }
+            // Réflexion de la composante normale, puis la particule finit le pas avec sa nouvelle vitesse.
+            // hit->fraction se rapporte au déplacement from -> to, qui ne couvre plus que remaining du pas.
+            // Le déplacement ne suit pas toujours la vitesse (correction des collisions entre particules) : une vitesse
+            // qui s'éloigne déjà du segment est gardée, la réfléchir la renverrait à travers ce segment, ignoré ensuite.
+            float const normal_speed = glm::dot(velocity, hit->normal);
+            if (normal_speed < 0.f)
+                velocity -= (1.f + heart_restitution) * normal_speed * hit->normal;
+            remaining *= 1.f - hit->fraction;
+            from = contact;
+            to = contact + velocity * (remaining * dt);
+            last_segment = hit->segment;
+        }
+
+        particles.position_x[i] = to.x;
+        particles.position_y[i] = to.y;
+        particles.velocity_x[i] = velocity.x;
+        particles.velocity_y[i] = velocity.y;
+    }
+}
+
+void Simulation::prepare() {
+    if (use_distance_field && !heart_field)
+        heart_field.emplace(make_heart_field());
+}
+
+void Simulation::step(float dt, float aspect_ratio) {
+    // Avant les tranches parallèles, qui ne font que lire la grille
+    prepare();
+    spawn_rain_particles(aspect_ratio);
+    spawn_heart_emitter_particles(dt);
+
+    // Arbre construit sur les positions du début du pas, avant que les tranches ne commencent à les modifier
+    if (particle_attraction != 0.f)
+        attraction_tree.build({particles.position_x.data(), particles.size()}, {particles.position_y.data(), particles.size()});
+
+    // Chaque tranche ne lit et n'écrit que ses propres particules : le résultat ne dépend pas du nombre de threads
+    thread_pool().parallel_for(particles.size(), particles_per_task, [&](size_t begin, size_t end) {
+        particles.save_previous_positions(begin, end);
+        compute_forces(begin, end);
+        integrate(particles, begin, end, dt);
+        if (collide_with_heart && !collide_particles)
+            collide_with_heart_polyline(begin, end, dt);
+    });
+
+    // Une fois que toutes les particules ont bougé : les voisines doivent être à leur nouvelle position
+    if (collide_particles) {
+        particle_collisions.resolve(particles);
+        // Les corrections des collisions déplacent aussi les particules (une pile pousse les plus basses dans le
+        // cœur) : le cœur est testé ensuite, sur tout le déplacement du pas
+        if (collide_with_heart) {
+            thread_pool().parallel_for(particles.size(), particles_per_task, [&](size_t begin, size_t end) {
+                collide_with_heart_polyline(begin, end, dt);
+            });
+        }
+    }
+
+    particles.remove_if([&](size_t i) {
+        return particles.position_y[i] < -1.2f;
+    });
+}
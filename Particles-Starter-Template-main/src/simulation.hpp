@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "arc_length_curve.hpp"
+#include "barnes_hut.hpp"
+#include "closest_point.hpp"
+#include "collisions.hpp"
+#include "forces.hpp"
+#include "heart_field.hpp"
+#include "particle_store.hpp"
+#include "point_sequences.hpp"
+#include "polyline_collider.hpp"
+#include "utils.hpp"
+
+// Pluie de particules autour du cœur. Ne dépend pas d'OpenGL : peut tourner sans fenêtre.
+struct Simulation {
+    // Pool préalloué au démarrage : la pluie n'alloue plus rien pendant la boucle.
+    // Même graine : mêmes particules, quel que soit le nombre de threads.
+    explicit Simulation(size_t max_particles = 100'000, uint64_t seed = utils::random_seed());
+
+    // Distance au cœur précalculée sur la zone où tombe la pluie (partagée avec GpuSimulation)
+    static HeartDistanceField make_heart_field();
+    // Polygone du cœur pour les collisions continues
+    static PolylineCollider make_heart_collider();
+    // Contour du cœur paramétré par la longueur d'arc, pour répartir des particules le long du contour
+    static ArcLengthCurve make_heart_outline();
+
+    ParticleStore particles;
+    // Calcul exact en dehors de la grille. Construite au premier pas avec use_distance_field (~150 000 nœuds) :
+    // rien n'est calculé avec --exact.
+    std::optional<HeartDistanceField> heart_field{};
+    // Particules créées en haut de l'écran à chaque pas
+    int rain_per_step = 5;
+    // Tirages de la pluie : un flux à part, qui ne dépend que de la graine
+    utils::RandomStream rain_random;
+    // Abscisses de la pluie prises dans une suite régulière (cf. set_rain_pattern()) ; vide : tirages de rain_random
+    std::optional<PointSource> rain_points{};
+    // Émetteur qui fait le tour du cœur à vitesse constante : à chaque pas, heart_emitter_per_step particules
+    // régulièrement espacées le long de l'arc qu'il vient de parcourir, juste à l'extérieur du cœur ; 0 : désactivé
+    int            heart_emitter_per_step = 0;
+    float          heart_emitter_speed    = 0.5f; // Longueur de contour parcourue par seconde
+    float          heart_emitter_position = 0.f;  // Distance parcourue depuis t = 0, le long du contour
+    ArcLengthCurve heart_outline          = make_heart_outline();
+    // Les particules se repoussent (grille de voisinage reconstruite à chaque pas) ; désactivé par défaut
+    bool               collide_particles = false;
+    ParticleCollisions particle_collisions{};
+    // Attraction en 1/d² entre toutes les particules (négative : répulsion), via un arbre de Barnes–Hut ; 0 : désactivée
+    float         particle_attraction = 0.f;
+    BarnesHutTree attraction_tree{};
+    // false : point le plus proche calculé exactement pour chaque particule, même dans la grille
+    bool use_distance_field = true;
+    // Au-delà de cette distance depuis la dernière recherche complète, on ne fait plus confiance au t du pas précédent
+    float warm_start_radius = 0.05f;
+    // Distance et normale du cœur de chaque particule pour le pas en cours, calculées avant les forces.
+    // Une case par particule possible (max_particles), allouée à la construction comme les colonnes de particles
+    std::vector<CurveDistance> heart_distances{};
+    // Le cœur devient solide : le déplacement de chaque particule pendant un pas est testé contre son polygone,
+    // et la particule rebondit au moment de l'impact (pas de traversée, même avec un grand dt) ; désactivé par défaut
+    bool             collide_with_heart = false;
+    float            heart_restitution  = 0.5f;
+    PolylineCollider heart_collider     = make_heart_collider();
+
+    // Construit ce dont les réglages ont besoin (grille de distance si use_distance_field). Appelé par step() ;
+    // à appeler avant pour ne pas compter la construction dans le premier pas.
+    void prepare();
+    // Un pas de simulation de durée dt (fixe, cf. SimulationClock)
+    void step(float dt, float aspect_ratio);
+    // Répartition des abscisses de la pluie (Sobol, bruit bleu, ...) : une pluie régulière couvre la largeur de l'écran
+    // avec moins de particules. La suite ne dépend que de la graine.
+    void set_rain_pattern(PointPattern pattern);
+
+private:
+    void spawn_rain_particles(float aspect_ratio);
+    void spawn_heart_emitter_particles(float dt);
+    // Forces : champ autour du cœur + gravité (+ attraction entre particules), pour les particules [begin, end)
+    void compute_forces(size_t begin, size_t end);
+    // Remplit heart_distances pour les particules [begin, end) et met à jour le point de départ du calcul exact
+    // (closest_t) : les forces, elles, ne modifient pas les particules
+    void update_heart_distances(size_t begin, size_t end);
+    // Distance et normale du cœur : grille précalculée si possible, sinon calcul exact
+    CurveDistance distance_to_heart(size_t i);
+    // Point du cœur le plus proche de la particule i, en repartant de celui du pas précédent si possible
+    ClosestPoint closest_point_on_heart_cached(size_t i);
+    // Rebonds sur le cœur pendant le pas qui vient d'être intégré, pour les particules [begin, end)
+    void collide_with_heart_polyline(size_t begin, size_t end, float dt);
+};
@@ -0,0 +1,24 @@
+#include "simulation_clock.hpp"
+#include <cmath>
+
+int SimulationClock::advance(float frame_dt)
+{
+    _accumulator += frame_dt;
+
+    int substeps = 0;
+    while (_accumulator >= fixed_dt && substeps < max_substeps)
+    {
+        _accumulator -= fixed_dt;
+        ++substeps;
+    }
+
+    // Retard impossible à rattraper : on le jette plutôt que de l'accumuler indéfiniment,
+    // en gardant la fraction de pas pour que l'interpolation reste continue
+    if (_accumulator >= fixed_dt)
+    {
+        float const kept = std::fmod(_accumulator, fixed_dt);
+        _dropped_time += _accumulator - kept;
+        _accumulator = kept;
+    }
+    return substeps;
+}
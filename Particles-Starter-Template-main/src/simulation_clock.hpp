@@ -0,0 +1,22 @@
+#pragma once
+
+// Horloge à pas fixe : le temps réel de chaque frame est accumulé puis découpé en pas de fixed_dt.
+// Si une frame a pris trop de temps, on ne fait que max_substeps pas et le reste est abandonné :
+// la simulation ralentit au lieu de faire un énorme pas qui ferait traverser le cœur aux particules.
+struct SimulationClock {
+    float fixed_dt     = 1.f / 120.f;
+    int   max_substeps = 8;
+
+    // Ajoute le temps de la frame et renvoie le nombre de pas de fixed_dt à simuler
+    int advance(float frame_dt);
+
+    // Position entre l'avant-dernier et le dernier pas simulés, dans [0, 1[, pour interpoler le rendu
+    float interpolation_alpha() const { return _accumulator / fixed_dt; }
+
+    // Temps total abandonné parce que max_substeps était atteint
+    float dropped_time() const { return _dropped_time; }
+
+private:
+    float _accumulator{0.f};
+    float _dropped_time{0.f};
+};
@@ -0,0 +1,69 @@
+#include "spatial_grid.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include "thread_pool.hpp"
+
+static constexpr size_t points_per_task = 4096;
+
+SpatialGrid::SpatialGrid(float cell_size)
+    : _cell_size{cell_size}
+{}
+
+bool SpatialGrid::bucket_seen_before(uint32_t bucket, glm::ivec2 min_cell, glm::ivec2 max_cell, glm::ivec2 cell) const
+{
+    for (int y = min_cell.y; y <= cell.y; ++y)
+    {
+        for (int x = min_cell.x; x <= max_cell.x; ++x)
+        {
+            if (y == cell.y && x == cell.x)
+                return false;
+            if (bucket_of({x, y}) == bucket)
+                return true;
+        }
+    }
+    return false;
+}
+
+void SpatialGrid::build(std::span<float const> x, std::span<float const> y)
+{
+    size_t const count = x.size();
+
+    // Environ deux seaux par point : peu de collisions de hash, et une table qui reste en cache
+    size_t const buckets_count = std::bit_ceil(std::max<size_t>(2 * count, 1));
+    _bucket_mask = static_cast<uint32_t>(buckets_count - 1);
+    _bucket_start.assign(buckets_count + 1, 0);
+    _bucket_cursor.resize(buckets_count);
+    _sorted.resize(count);
+    _point_bucket.resize(count);
+
+    // 1. Comptage : _bucket_start[b + 1] = nombre de points dans le seau b
+    thread_pool().parallel_for(count, points_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            uint32_t const bucket = bucket_of(cell_of({x[i], y[i]}));
+            _point_bucket[i]      = bucket;
+            std::atomic_ref<uint32_t>{_bucket_start[bucket + 1]}.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // 2. Somme préfixe : début de chaque seau (une passe linéaire sur la table, négligeable devant le reste)
+    for (size_t b = 0; b < buckets_count; ++b)
+        _bucket_start[b + 1] += _bucket_start[b];
+    std::copy(_bucket_start.begin(), _bucket_start.end() - 1, _bucket_cursor.begin());
+
+    // 3. Rangement : chaque point prend la prochaine place libre de son seau
+    thread_pool().parallel_for(count, points_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            uint32_t const slot = std::atomic_ref<uint32_t>{_bucket_cursor[_point_bucket[i]]}.fetch_add(1, std::memory_order_relaxed);
+            _sorted[slot]       = static_cast<uint32_t>(i);
+        }
+    });
+
+    // 4. L'ordre d'arrivée dans un seau dépend des threads : on le rend déterministe (les seaux sont petits)
+    thread_pool().parallel_for(buckets_count, points_per_task, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b)
+            std::sort(_sorted.begin() + _bucket_start[b], _sorted.begin() + _bucket_start[b + 1]);
+    });
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Grille uniforme infinie, hachée dans une table de taille fixe (spatial hash), reconstruite à chaque pas.
+// build() range les indices des points par case avec un tri par comptage parallèle : O(N) par pas.
+// Deux cases différentes peuvent tomber dans le même seau : les candidats renvoyés par for_each_candidate()
+// sont un sur-ensemble des voisins, c'est à l'appelant de tester la distance.
+// L'ordre des indices dans un seau ne dépend pas du nombre de threads (ils sont triés après le rangement).
+class SpatialGrid {
+public:
+    // Pour chercher les voisins à une distance d, une taille de case d'environ d ne parcourt que 3 × 3 cases
+    explicit SpatialGrid(float cell_size);
+
+    float cell_size() const { return _cell_size; }
+
+    // Range les points (x[i], y[i]), i < x.size() (la grille ne garde que leurs indices)
+    void build(std::span<float const> x, std::span<float const> y);
+
+    // Appelle callback(j) pour chaque point j rangé dans une case qui touche le disque (position, radius).
+    // Chaque j n'est vu qu'une fois, même si plusieurs cases du disque partagent un seau.
+    template<typename Callback>
+    void for_each_candidate(glm::vec2 position, float radius, Callback&& callback) const
+    {
+        if (_sorted.empty())
+            return;
+        glm::ivec2 const min_cell = cell_of(position - radius);
+        glm::ivec2 const max_cell = cell_of(position + radius);
+
+        // Cas courant (rayon de l'ordre d'une case) : les seaux déjà parcourus sont gardés dans un petit tableau
+        std::array<uint32_t, 16> visited;
+        size_t                   visited_count = 0;
+        bool const               few_cells     = (max_cell.x - min_cell.x + 1) * (max_cell.y - min_cell.y + 1) <= static_cast<int>(visited.size());
+
+        for (int y = min_cell.y; y <= max_cell.y; ++y)
+        {
+            for (int x = min_cell.x; x <= max_cell.x; ++x)
+            {
+                uint32_t const bucket = bucket_of({x, y});
+                if (few_cells)
+                {
+                    if (std::find(visited.begin(), visited.begin() + static_cast<std::ptrdiff_t>(visited_count), bucket) != visited.begin() + static_cast<std::ptrdiff_t>(visited_count))
+                        continue;
+                    visited[visited_count++] = bucket;
+                }
+                else if (bucket_seen_before(bucket, min_cell, max_cell, {x, y}))
+                {
+                    continue;
+                }
+                for (uint32_t k = _bucket_start[bucket]; k < _bucket_start[bucket + 1]; ++k)
+                    callback(static_cast<size_t>(_sorted[k]));
+            }
+        }
+    }
+
+private:
+    glm::ivec2 cell_of(glm::vec2 position) const { return glm::ivec2{glm::floor(position / _cell_size)}; }
+    uint32_t   bucket_of(glm::ivec2 cell) const
+    {
+        // Hash classique de Teschner et al. pour les grilles de collision
+        return ((static_cast<uint32_t>(cell.x) * 73856093u) ^ (static_cast<uint32_t>(cell.y) * 19349663u)) & _bucket_mask;
+    }
+    // Une case parcourue avant cell (dans l'ordre de for_each_candidate()) est-elle dans ce seau ?
+    bool bucket_seen_before(uint32_t bucket, glm::ivec2 min_cell, glm::ivec2 max_cell, glm::ivec2 cell) const;
+
+private:
+    float    _cell_size;
+    uint32_t _bucket_mask{0}; // Nombre de seaux - 1 (une puissance de 2)
+
+    std::vector<uint32_t> _bucket_start{};  // Les points du seau b sont _sorted[_bucket_start[b], _bucket_start[b + 1])
+    std::vector<uint32_t> _sorted{};        // Indices des points, rangés par seau
+    std::vector<uint32_t> _point_bucket{};  // Seau de chaque point
+    std::vector<uint32_t> _bucket_cursor{}; // Prochaine place libre de chaque seau pendant le rangement
+};
@@ -0,0 +1,127 @@
+#include "static_curve.hpp"
+#include <utility>
+#include "polyline_renderer.hpp"
+
+static auto make_static_curve_shader() -> gl::Shader
+{
+    return gl::Shader{
+        gl::Shader_Descriptor{
+            .vertex = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec4 in_color;
+
+out vec4 v_color;
+
+void main()
+{
+    gl_Position = vec4(in_position, 0., 1.);
+    v_color = in_color;
+}
+)GLSL"}),
+            .fragment = gl::ShaderSource::Code({R"GLSL(
+#version 410
+
+in vec4 v_color;
+out vec4 out_color;
+
+void main()
+{
+    out_color = v_color;
+}
+)GLSL"}),
+        }
+    };
+}
+
+StaticCurve::StaticCurve(std::function<glm::vec2(float)> parametric, int segments, float thickness, glm::vec4 const& color)
+    : _parametric{std::move(parametric)}
+    , _segments{segments}
+    , _thickness{thickness}
+    , _color{color}
+{}
+
+void StaticCurve::set_parametric(std::function<glm::vec2(float)> parametric)
+{
+    _parametric     = std::move(parametric);
+    _needs_sampling = true;
+    _mesh.reset();
+}
+
+void StaticCurve::set_segments(int segments)
+{
+    if (segments == _segments)
+        return;
+    _segments       = segments;
+    _needs_sampling = true;
+    _mesh.reset();
+}
+
+void StaticCurve::set_thickness(float thickness)
+{
+    if (thickness == _thickness)
+        return;
+    _thickness = thickness;
+    _mesh.reset();
+}
+
+void StaticCurve::set_color(glm::vec4 const& color)
+{
+    if (color == _color)
+        return;
+    _color = color;
+    _mesh.reset();
+}
+
+void StaticCurve::sample()
+{
+    _samples.resize(static_cast<size_t>(_segments) + 1);
+    for (int i = 0; i <= _segments; ++i)
+        _samples[static_cast<size_t>(i)] = _parametric(static_cast<float>(i) / _segments);
+    _needs_sampling = false;
+}
+
+void StaticCurve::tessellate(float aspect_ratio)
+{
+    if (_needs_sampling)
+        sample();
+
+    // Passage dans le repère de l'écran avant de décaler les bords de la ligne
+    std::vector<glm::vec2> points(_samples.size());
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i] = _samples[i] * glm::vec2(1.f / aspect_ratio, 1.f);
+    bool closed = glm::distance(_samples.front(), _samples.back()) < 1e-6f;
+
+    std::vector<PolylineVertex> vertices{};
+    std::vector<uint32_t>       indices{};
+    tessellate_polyline(points, {&_thickness, 1}, {&_color, 1}, closed, /* miter_limit = */ 4.f, vertices, indices);
+
+    std::vector<float> data{};
+    data.reserve(vertices.size() * 6);
+    for (PolylineVertex const& vertex : vertices)
+        data.insert(data.end(), {vertex.position.x, vertex.position.y, vertex.color.r, vertex.color.g, vertex.color.b, vertex.color.a});
+
+    _mesh.emplace(gl::Mesh_Descriptor{
+        .vertex_buffers = {
+            gl::VertexBuffer_Descriptor{
+                .layout = {gl::VertexAttribute::Position2D(0), gl::VertexAttribute::ColorRGBA(1)},
+                .data   = data,
+            }
+        },
+        .index_buffer = indices,
+    });
+    _mesh_aspect_ratio = aspect_ratio;
+}
+
+void StaticCurve::draw()
+{
+    static auto shader = make_static_curve_shader();
+
+    float aspect_ratio = gl::framebuffer_aspect_ratio();
+    if (!_mesh || aspect_ratio != _mesh_aspect_ratio)
+        tessellate(aspect_ratio);
+
+    shader.bind();
+    _mesh->draw();
+}
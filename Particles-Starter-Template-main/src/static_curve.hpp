@@ -0,0 +1,37 @@
+#pragma once
+#include <functional>
+#include <optional>
+#include <vector>
+#include "opengl-framework/opengl-framework.hpp"
+
+// Courbe paramétrique qui ne change pas d'une frame à l'autre (le contour du cœur par exemple) :
+// elle est échantillonnée et découpée en triangles une seule fois dans un gl::Mesh, puis redessinée en un draw call.
+// Le découpage est fait dans le repère de l'écran, pour que l'épaisseur soit la même dans toutes les directions ;
+// il est donc refait quand le rapport largeur / hauteur du framebuffer change, ou quand un paramètre change.
+// Doit être construit après gl::init().
+class StaticCurve {
+public:
+    StaticCurve(std::function<glm::vec2(float)> parametric, int segments, float thickness, glm::vec4 const& color);
+
+    void set_parametric(std::function<glm::vec2(float)> parametric);
+    void set_segments(int segments);
+    void set_thickness(float thickness);
+    void set_color(glm::vec4 const& color);
+
+    void draw();
+
+private:
+    void sample();
+    void tessellate(float aspect_ratio);
+
+private:
+    std::function<glm::vec2(float)> _parametric;
+    int                             _segments;
+    float                           _thickness;
+    glm::vec4                       _color;
+
+    std::vector<glm::vec2>  _samples{};       // Points de la courbe, gardés pour ne pas réévaluer _parametric quand seul l'aspect change
+    bool                    _needs_sampling{true};
+    std::optional<gl::Mesh> _mesh{};          // Vide tant que la courbe n'a pas été découpée, ou après un changement de paramètre
+    float                   _mesh_aspect_ratio{0.f};
+};
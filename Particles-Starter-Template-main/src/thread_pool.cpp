@@ -0,0 +1,134 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cassert>
+
+ThreadPool::ThreadPool(size_t threads_count)
+{
+    threads_count = std::max<size_t>(threads_count, 1);
+    for (size_t i = 0; i < threads_count; ++i)
+        _queues.push_back(std::make_unique<Queue>());
+    for (size_t i = 1; i < threads_count; ++i)
+        _workers.emplace_back([this, i]() { worker_loop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{_wake_mutex};
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers)
+        worker.join();
+}
+
+void ThreadPool::parallel_for(size_t count, size_t chunk_size, std::function<void(size_t, size_t)> const& task)
+{
+    if (count == 0)
+        return;
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    size_t const chunks_count = (count + chunk_size - 1) / chunk_size;
+
+    // Pas la peine de réveiller les workers s'il n'y a qu'une tranche
+    if (chunks_count == 1 || threads_count() == 1)
+    {
+        for (size_t begin = 0; begin < count; begin += chunk_size)
+            task(begin, std::min(begin + chunk_size, count));
+        return;
+    }
+
+    assert(_remaining_chunks == 0 && "parallel_for() ne doit pas être appelé depuis une tâche");
+    _task = &task;
+    _remaining_chunks.store(chunks_count);
+
+    // Chaque thread reçoit un bloc contigu de tranches, pour garder la localité mémoire
+    size_t const chunks_per_queue = (chunks_count + threads_count() - 1) / threads_count();
+    for (size_t chunk = 0; chunk < chunks_count; ++chunk)
+    {
+        size_t const begin = chunk * chunk_size;
+        Queue&       queue = *_queues[chunk / chunks_per_queue];
+        std::lock_guard lock{queue.mutex};
+        queue.chunks.push_back({begin, std::min(begin + chunk_size, count)});
+    }
+
+    {
+        std::lock_guard lock{_wake_mutex};
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    run_chunks(0);
+    while (_remaining_chunks.load() != 0) // Les dernières tranches sont peut-être encore en cours sur d'autres threads
+        std::this_thread::yield();
+    _task = nullptr;
+}
+
+bool ThreadPool::pop_or_steal(size_t queue_index, Range& range)
+{
+    { // D'abord dans sa propre file, dans l'ordre
+        Queue&          queue = *_queues[queue_index];
+        std::lock_guard lock{queue.mutex};
+        if (!queue.chunks.empty())
+        {
+            range = queue.chunks.front();
+            queue.chunks.pop_front();
+            return true;
+        }
+    }
+    // Sinon on vole la fin de la file d'un autre thread, loin de ce qu'il est en train de traiter
+    for (size_t offset = 1; offset < _queues.size(); ++offset)
+    {
+        Queue&          victim = *_queues[(queue_index + offset) % _queues.size()];
+        std::lock_guard lock{victim.mutex};
+        if (!victim.chunks.empty())
+        {
+            range = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run_chunks(size_t queue_index)
+{
+    Range range{};
+    while (pop_or_steal(queue_index, range))
+    {
+        (*_task)(range.begin, range.end);
+        _remaining_chunks.fetch_sub(1);
+    }
+}
+
+void ThreadPool::worker_loop(size_t queue_index)
+{
+    size_t seen_generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{_wake_mutex};
+            _wake.wait(lock, [&]() { return _stop || _generation != seen_generation; });
+            if (_stop)
+                return;
+            seen_generation = _generation;
+        }
+        run_chunks(queue_index);
+    }
+}
+
+static size_t& requested_thread_pool_size()
+{
+    static size_t size = 0;
+    return size;
+}
+
+void set_thread_pool_size(size_t threads_count)
+{
+    requested_thread_pool_size() = threads_count;
+}
+
+ThreadPool& thread_pool()
+{
+    static ThreadPool pool{requested_thread_pool_size() != 0 ? requested_thread_pool_size() : std::thread::hardware_concurrency()};
+    return pool;
+}
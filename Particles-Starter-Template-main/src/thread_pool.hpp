@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads avec vol de tâches (work stealing).
+// parallel_for() découpe [0, count) en tranches de chunk_size éléments, réparties entre les files
+// des threads ; un thread qui a vidé sa file vole des tranches dans celles des autres, ce qui
+// équilibre les tranches dont le coût varie.
+// Le découpage ne dépend que de count et chunk_size : tant que chaque tranche n'écrit que dans ses
+// propres éléments, le résultat est identique bit à bit quel que soit le nombre de threads.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+    ThreadPool(ThreadPool const&)                    = delete;
+    ThreadPool& operator=(ThreadPool const&)         = delete;
+
+    // Nombre de threads qui travaillent pendant un parallel_for(), thread appelant compris
+    size_t threads_count() const { return _queues.size(); }
+
+    // Appelle task(begin, end) pour chaque tranche, et attend qu'elles soient toutes traitées.
+    // Le thread appelant participe. Ne doit pas être appelé depuis une tâche.
+    void parallel_for(size_t count, size_t chunk_size, std::function<void(size_t begin, size_t end)> const& task);
+
+private:
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+    struct Queue {
+        std::mutex        mutex;
+        std::deque<Range> chunks;
+    };
+
+    bool pop_or_steal(size_t queue_index, Range& range);
+    void run_chunks(size_t queue_index);
+    void worker_loop(size_t queue_index);
+
+private:
+    std::vector<std::unique_ptr<Queue>> _queues; // Une file par thread, la 0 est celle du thread appelant
+    std::vector<std::thread>            _workers;
+
+    std::function<void(size_t, size_t)> const* _task{nullptr};
+    std::atomic<size_t>                        _remaining_chunks{0};
+
+    std::mutex              _wake_mutex;
+    std::condition_variable _wake;
+    size_t                  _generation{0}; // Incrémenté à chaque parallel_for() pour réveiller les workers
+    bool                    _stop{false};
+};
+
+// Pool partagé par toute la simulation
+ThreadPool& thread_pool();
+// À appeler avant le premier thread_pool() pour choisir le nombre de threads (0 = tous les cœurs)
+void set_thread_pool_size(size_t threads_count);
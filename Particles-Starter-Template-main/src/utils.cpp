@@ -1,18 +1,196 @@
 #include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <random>
+#include "closest_point.hpp"
+#include "simd.hpp"
 #include "opengl-framework/opengl-framework.hpp"
 
 namespace utils {
 
-static auto& generator()
+// Hash 32 bits -> 32 bits bijectif (lowbias32 de C. Wellons) : deux entrées voisines donnent des sorties sans rapport
+static uint32_t hash32(uint32_t x)
 {
-    thread_local std::default_random_engine gen{std::random_device{}()};
-    return gen;
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Finaliseur de splitmix64 : dérive les clés des flux
+static uint64_t hash64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+// 24 bits de poids fort -> [0, 1), tous les flottants de la forme k / 2^24
+static float unit_float(uint32_t bits)
+{
+    return static_cast<float>(static_cast<int32_t>(bits >> 8)) * 0x1p-24f;
+}
+
+// [0, 2^32) -> [0, range) par multiplication (Lemire) : pas de division ni de rejet, biais inférieur à range / 2^32
+static uint32_t bounded(uint32_t bits, uint64_t range)
+{
+    return static_cast<uint32_t>((static_cast<uint64_t>(bits) * range) >> 32);
+}
+
+static uint64_t int_range(int min, int max)
+{
+    return static_cast<uint64_t>(static_cast<int64_t>(max) - static_cast<int64_t>(min)) + 1;
+}
+
+RandomStream::RandomStream(uint64_t seed)
+    : _key{hash64(seed)}
+{
+    update_block();
+}
+
+RandomStream RandomStream::split(uint64_t id) const
+{
+    // Ne dépend que de la clé et de id, pas de la position dans le flux parent
+    RandomStream child{*this};
+    child._key  = hash64(_key ^ hash64(id + 0x9e3779b97f4a7c15ull));
+    child._high = 0;
+    child._low  = 0;
+    child.update_block();
+    return child;
+}
+
+void RandomStream::update_block()
+{
+    _offset = hash32(static_cast<uint32_t>(_key) ^ hash32(_high));
+    _mask   = hash32(static_cast<uint32_t>(_key >> 32) ^ _offset);
+}
+
+// Le n-ième tirage, low = n mod 2^32 : le second hash mélange la partie haute de la clé, pour que deux flux
+// ne soient jamais le même flux décalé (ce que donnerait hash32(offset + low) seul)
+static uint32_t draw(uint32_t offset, uint32_t mask, uint32_t low)
+{
+    return hash32(hash32(offset + low) ^ mask);
+}
+
+uint32_t RandomStream::next_bits()
+{
+    uint32_t const bits = draw(_offset, _mask, _low);
+    advance(1);
+    return bits;
+}
+
+void RandomStream::advance(uint64_t count)
+{
+    uint64_t const low = uint64_t{_low} + count;
+    _low               = static_cast<uint32_t>(low);
+    if (low >> 32)
+    {
+        ++_high;
+        update_block();
+    }
+}
+
+float RandomStream::uniform(float min, float max)
+{
+    return min + (max - min) * unit_float(next_bits());
+}
+
+int RandomStream::uniform_int(int min, int max)
+{
+    return static_cast<int>(static_cast<int64_t>(min) + bounded(next_bits(), int_range(min, max)));
+}
+
+// Appelle fill(begin, count) par blocs de tirages consécutifs qui partagent le même bloc de clés
+template<typename Fill>
+void RandomStream::fill_by_blocks(size_t size, Fill&& fill)
+{
+    size_t begin = 0;
+    while (begin < size)
+    {
+        size_t const count = static_cast<size_t>(std::min<uint64_t>(size - begin, (uint64_t{1} << 32) - _low));
+        fill(begin, count);
+        advance(count);
+        begin += count;
+    }
+}
+
+void RandomStream::fill(std::span<float> out, float min, float max)
+{
+    float const scale = max - min;
+    fill_by_blocks(out.size(), [&](size_t begin, size_t count) {
+        float* const   dst    = out.data() + begin;
+        uint32_t const offset = _offset + _low;
+        uint32_t const mask   = _mask;
+        for (size_t k = 0; k < count; ++k)
+            dst[k] = min + scale * unit_float(draw(offset, mask, static_cast<uint32_t>(k)));
+    });
+}
+
+void RandomStream::fill(std::span<int> out, int min, int max)
+{
+    uint64_t const range = int_range(min, max);
+    fill_by_blocks(out.size(), [&](size_t begin, size_t count) {
+        int* const     dst    = out.data() + begin;
+        uint32_t const offset = _offset + _low;
+        uint32_t const mask   = _mask;
+        for (size_t k = 0; k < count; ++k)
+            dst[k] = static_cast<int>(static_cast<int64_t>(min) + bounded(draw(offset, mask, static_cast<uint32_t>(k)), range));
+    });
+}
+
+static std::optional<uint64_t>& requested_random_seed()
+{
+    static std::optional<uint64_t> seed{};
+    return seed;
+}
+
+void set_random_seed(uint64_t seed)
+{
+    requested_random_seed() = seed;
+}
+
+uint64_t random_seed()
+{
+    static uint64_t const seed = requested_random_seed().value_or((uint64_t{std::random_device{}()} << 32) | std::random_device{}());
+    return seed;
+}
+
+// Flux de chaque thread pour rand() / rand_int() / rand_fill(), tous dérivés du flux réservé thread_streams_id de la
+// graine globale : le thread principal (le premier à tirer) a le premier, les autres les suivants dans l'ordre où ils
+// commencent à tirer
+static RandomStream& generator()
+{
+    static std::atomic<uint64_t> next_thread_stream{0};
+    thread_local RandomStream    stream = RandomStream{random_seed()}.split(thread_streams_id).split(next_thread_stream++);
+    return stream;
 }
 
 float rand(float min, float max)
 {
-    return std::uniform_real_distribution<float>{min, max}(generator());
+    return generator().uniform(min, max);
+}
+
+int rand_int(int min, int max)
+{
+    return generator().uniform_int(min, max);
+}
+
+void rand_fill(std::span<float> out, float min, float max)
+{
+    generator().fill(out, min, max);
+}
+
+void rand_fill(std::span<int> out, int min, int max)
+{
+    generator().fill(out, min, max);
 }
 
 static auto make_square_mesh() -> gl::Mesh
@@ -156,8 +334,10 @@ std::optional<glm::vec2> segment_intersection(
     glm::vec2 qp = q1 - p1;
     float qpxr = qp.x * r.y - qp.y * r.x;
 
-    // Si rxs == 0, les segments sont colinéaires ou parallèles (on ignore ce cas comme demandé)
-    if (std::abs(rxs) < 1e-8f) return std::nullopt;
+    // Si rxs == 0, les segments sont colinéaires ou parallèles (on ignore ce cas comme demandé).
+    // Seuil relatif aux longueurs : des segments très courts (contour du cœur près de sa pointe) ne passent pas
+    // pour parallèles. Un segment de longueur nulle ne croise rien.
+    if (std::abs(rxs) <= 1e-8f * glm::length(r) * glm::length(s)) return std::nullopt;
 
     float t = (qp.x * s.y - qp.y * s.x) / rxs;
     float u = qpxr / rxs;
@@ -194,11 +374,6 @@ std::optional<glm::vec2> segment_circle_intersection(glm::vec2 p1, glm::vec2 p2,
     return std::nullopt;
 }
 
-int rand_int(int min, int max)
-{
-    return static_cast<int>(std::floor(utils::rand(static_cast<float>(min), static_cast<float>(max) + 1.f)));
-}
-
 // Interpolation linéaire
 glm::vec2 lerp(glm::vec2 a, glm::vec2 b, float t) {
     return (1 - t) * a + t * b;
@@ -265,31 +440,220 @@ glm::vec2 bezier3_derivative(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2
          + 3.f * t * t * (p3 - p2);
 }
 
+glm::vec2 bezier3_second_derivative(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, float t) {
+    float u = 1.f - t;
+    return 6.f * u * (p2 - 2.f * p1 + p0)
+         + 6.f * t * (p3 - 2.f * p2 + p1);
+}
+
 float find_closest_t_on_bezier(glm::vec2 point, glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3) {
-    float t = 0.5f;                 // point de départ
-    float learning_rate = 0.01f;    // η
-    int max_iterations = 100;
-    float epsilon = 1e-5f;
+    // Échantillons pour trouver le minimum global (évaluations polynomiales, peu coûteuses)
+    constexpr int samples_count = 16;
+    std::array<glm::vec2, samples_count> samples;
+    for (int i = 0; i < samples_count; ++i)
+        samples[i] = bezier3_bernstein(p0, p1, p2, p3, static_cast<float>(i) / (samples_count - 1));
+
+    auto evaluate = [&](float t) {
+        return CurveDerivatives{
+            .position = bezier3_bernstein(p0, p1, p2, p3, t),
+            .first = bezier3_derivative(p0, p1, p2, p3, t),
+            .second = bezier3_second_derivative(p0, p1, p2, p3, t),
+        };
+    };
+
+    // Newton avec dérivées analytiques à partir du meilleur échantillon
+    return find_closest_point(point, evaluate, samples, false).t;
+}
+
+namespace {
+// Bézier cubique sous forme polynomiale, B(t) = ((a t + b) t + c) t + d, évaluée sur simd::width valeurs de t à la fois
+struct Bezier3Polynomial {
+    glm::vec2 a, b, c, d;
 
-    for (int i = 0; i < max_iterations; ++i) {
-        glm::vec2 pt_on_curve = bezier3_bernstein(p0, p1, p2, p3, t);
-        glm::vec2 d_curve_dt = bezier3_derivative(p0, p1, p2, p3, t);
+    Bezier3Polynomial(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3)
+        : a{-p0 + 3.f * p1 - 3.f * p2 + p3}
+        , b{3.f * p0 - 6.f * p1 + 3.f * p2}
+        , c{-3.f * p0 + 3.f * p1}
+        , d{p0}
+    {}
+};
 
-        glm::vec2 diff = pt_on_curve - point;
+struct Vec2V {
+    simd::float_v x, y;
+};
 
-        // f(t) = ||B(t) - P||^2 → f'(t) = 2 (B(t) - P) · B'(t)
-        float grad = 2.f * glm::dot(diff, d_curve_dt);
+inline simd::float_v dot(Vec2V u, Vec2V v)
+{
+    return u.x * v.x + u.y * v.y;
+}
 
-        // Mise à jour de t
-        t -= learning_rate * grad;
-        t = glm::clamp(t, 0.f, 1.f);
+struct RefinedV {
+    simd::float_v t;
+    simd::float_v distance2;
+};
 
-        if (std::abs(grad) < epsilon) break;
+// Même affinage que find_closest_point() (Newton à partir de t0, gardé dans [center - spacing, center + spacing],
+// sécante ou bissection sinon), fait voie par voie sans branchement. Les voies qui ont convergé ne bougent plus.
+RefinedV refine_on_bezier(Bezier3Polynomial const& curve, Vec2V point, simd::float_v t0, float center, float spacing)
+{
+    using namespace simd;
+    float_v const zero = broadcast(0.f);
+    float_v const one  = broadcast(1.f);
+    float_v const half = broadcast(0.5f);
+    float_v const tol  = broadcast(1e-6f);
+
+    float_v const ax = broadcast(curve.a.x), ay = broadcast(curve.a.y);
+    float_v const bx = broadcast(curve.b.x), by = broadcast(curve.b.y);
+    float_v const cx = broadcast(curve.c.x), cy = broadcast(curve.c.y);
+    float_v const dx = broadcast(curve.d.x), dy = broadcast(curve.d.y);
+
+    float_v t    = t0;
+    float_v lo   = broadcast(std::max(center - spacing, 0.f));
+    float_v hi   = broadcast(std::min(center + spacing, 1.f));
+    float_v g_lo = broadcast(NAN);
+    float_v g_hi = broadcast(NAN);
+
+    RefinedV res{t0, broadcast(INFINITY)};
+    mask_v   done = zero < zero; // Tout à faux
+
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        Vec2V const position{((ax * t + bx) * t + cx) * t + dx, ((ay * t + by) * t + cy) * t + dy};
+        Vec2V const first{(broadcast(3.f) * ax * t + broadcast(2.f) * bx) * t + cx, (broadcast(3.f) * ay * t + broadcast(2.f) * by) * t + cy};
+        Vec2V const second{broadcast(6.f) * ax * t + broadcast(2.f) * bx, broadcast(6.f) * ay * t + broadcast(2.f) * by};
+        Vec2V const diff{position.x - point.x, position.y - point.y};
+
+        float_v const g         = dot(diff, first);
+        float_v const h         = dot(first, first) + dot(diff, second);
+        float_v const distance2 = dot(diff, diff);
+
+        mask_v const better = distance2 < res.distance2;
+        res.t               = select(better, t, res.t);
+        res.distance2       = select(better, distance2, res.distance2);
+
+        // Minimum sur une extrémité
+        done |= ((t <= zero) & (g >= zero)) | ((t >= one) & (g <= zero));
+
+        mask_v const descending_left = g > zero;
+        hi                           = select(descending_left, t, hi);
+        g_hi                         = select(descending_left, g, g_hi);
+        lo                           = select(descending_left, lo, t);
+        g_lo                         = select(descending_left, g_lo, g);
+
+        // Les comparaisons avec NaN sont fausses : une division par 0 ou une borne inconnue font passer au cas suivant
+        float_v const newton    = t - g / h;
+        float_v const secant    = lo - g_lo * (hi - lo) / (g_hi - g_lo);
+        float_v const midpoint  = (lo + hi) * half;
+        mask_v const  newton_ok = (zero < h) & (lo < newton) & (newton < hi);
+        mask_v const  secant_ok = (lo < secant) & (secant < hi);
+        float_v const next      = select(newton_ok, newton, select(secant_ok, secant, midpoint));
+
+        done |= (abs(next - t) < tol) | (hi - lo < tol);
+        t = select(done, t, next);
+        if (all(done))
+            break;
     }
-
-    return t;
+    return res;
 }
+} // namespace
+
+void find_closest_t_on_bezier(std::span<glm::vec2 const> points, glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, std::span<float> t_out, std::span<float> distance_out)
+{
+    assert(t_out.size() == points.size() && distance_out.size() == points.size());
+    using namespace simd;
+
+    // Calculé une fois pour toute la courbe : forme polynomiale et échantillons pour le minimum global
+    Bezier3Polynomial const curve{p0, p1, p2, p3};
+
+    constexpr int                        samples_count = 16;
+    constexpr float                      spacing       = 1.f / (samples_count - 1);
+    std::array<glm::vec2, samples_count> samples;
+    for (int i = 0; i < samples_count; ++i)
+        samples[i] = bezier3_bernstein(p0, p1, p2, p3, static_cast<float>(i) * spacing);
+    // Écart avec le plus éloigné des deux échantillons voisins, comme dans find_closest_point()
+    std::array<float, samples_count> margins;
+    for (int i = 0; i < samples_count; ++i)
+        margins[i] = std::max(glm::length(samples[i] - samples[std::max(i - 1, 0)]), glm::length(samples[i] - samples[std::min(i + 1, samples_count - 1)]));
+
+    for (size_t first = 0; first < points.size(); first += width)
+    {
+        size_t const lanes = std::min(width, points.size() - first);
+
+        // Les dernières voies répètent le dernier point quand il en reste moins que simd::width
+        alignas(64) float lane_x[width];
+        alignas(64) float lane_y[width];
+        for (size_t lane = 0; lane < width; ++lane)
+        {
+            glm::vec2 const p = points[first + std::min(lane, lanes - 1)];
+            lane_x[lane]      = p.x;
+            lane_y[lane]      = p.y;
+        }
+        Vec2V const point{load(lane_x), load(lane_y)};
+
+        // Parcours des échantillons : meilleur échantillon par voie
+        float_v distance2[samples_count];
+        float_v best_distance2 = broadcast(INFINITY);
+        float_v best_index     = broadcast(0.f);
+        for (int i = 0; i < samples_count; ++i)
+        {
+            float_v const dx = broadcast(samples[i].x) - point.x;
+            float_v const dy = broadcast(samples[i].y) - point.y;
+            distance2[i]     = dx * dx + dy * dy;
+            mask_v const better = distance2[i] < best_distance2;
+            best_distance2      = select(better, distance2[i], best_distance2);
+            best_index          = select(better, broadcast(static_cast<float>(i)), best_index);
+        }
+
+        // Départ au sommet de la parabole des distances² de l'échantillon i et de ses voisins, comme find_closest_point()
+        auto const refine = [&](int i) {
+            float const t      = static_cast<float>(i) * spacing;
+            float_v     offset = broadcast(0.f);
+            if (i > 0 && i < samples_count - 1)
+            {
+                float_v const curvature = distance2[i - 1] - broadcast(2.f) * distance2[i] + distance2[i + 1];
+                float_v const vertex    = min(max(broadcast(0.5f) * (distance2[i - 1] - distance2[i + 1]) / curvature, broadcast(-0.5f)), broadcast(0.5f));
+                offset                  = select(broadcast(0.f) < curvature, vertex, offset);
+            }
+            return refine_on_bezier(curve, point, broadcast(t) + offset * broadcast(spacing), t, spacing);
+        };
+
+        // Affinage du meilleur échantillon : chaque voie a le sien, on affine chaque indice qui l'est pour au moins une voie
+        RefinedV res{broadcast(0.f), broadcast(INFINITY)};
+        for (int i = 0; i < samples_count; ++i)
+        {
+            mask_v const is_best = abs(best_index - broadcast(static_cast<float>(i))) < broadcast(0.5f);
+            if (!any(is_best))
+                continue;
+            RefinedV const refined = refine(i);
+            res.t                  = select(is_best, refined.t, res.t);
+            res.distance2          = select(is_best, refined.distance2, res.distance2);
+        }
 
+        // Mêmes candidats que find_closest_point(), dans le même ordre : tout autre minimum local des échantillons
+        // pas plus loin que le meilleur point trouvé jusque-là, à un écart entre échantillons près
+        for (int i = 0; i < samples_count; ++i)
+        {
+            mask_v const is_local_minimum = (distance2[i] <= distance2[std::max(i - 1, 0)]) & (distance2[i] <= distance2[std::min(i + 1, samples_count - 1)]);
+            mask_v const is_near_best     = abs(broadcast(static_cast<float>(i)) - best_index) <= broadcast(1.f);
+            mask_v const candidate        = is_local_minimum & !is_near_best & (sqrt(distance2[i]) < sqrt(res.distance2) + broadcast(margins[i]));
+            if (!any(candidate))
+                continue;
+            RefinedV const other = refine(i);
+            mask_v const   take  = candidate & (other.distance2 < res.distance2);
+            res.t                = select(take, other.t, res.t);
+            res.distance2        = select(take, other.distance2, res.distance2);
+        }
 
+        alignas(64) float lane_t[width];
+        alignas(64) float lane_distance[width];
+        store(lane_t, res.t);
+        store(lane_distance, sqrt(res.distance2));
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            t_out[first + lane]        = lane_t[lane];
+            distance_out[first + lane] = lane_distance[lane];
+        }
+    }
+}
 
 } // namespace utils
@@ -1,9 +1,56 @@
 #pragma once
 #include "glm/glm.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <span>
 
 namespace utils {
 
+// Flux de nombres aléatoires reproductible : le n-ième tirage est un hash de (clé, n), sans autre état que le compteur.
+// split() crée des flux indépendants (un par thread, tranche ou émetteur) qui ne dépendent que de la graine et de leur
+// numéro : tant que chaque tâche tire dans le flux de sa tranche, le résultat ne dépend pas du nombre de threads.
+class RandomStream {
+public:
+    explicit RandomStream(uint64_t seed);
+
+    // Flux numéro id dérivé de celui-ci (sa position dans son propre flux n'y change rien)
+    RandomStream split(uint64_t id) const;
+
+    uint32_t next_bits();
+    // Uniforme dans [min, max)
+    float uniform(float min, float max);
+    // Uniforme dans [min, max] (bornes comprises)
+    int uniform_int(int min, int max);
+    // Mêmes valeurs que des appels successifs à uniform() / uniform_int(), en une boucle vectorisée
+    void fill(std::span<float> out, float min, float max);
+    void fill(std::span<int> out, int min, int max);
+
+    // Saute count tirages
+    void advance(uint64_t count);
+
+private:
+    void update_block();
+    template<typename Fill>
+    void fill_by_blocks(size_t size, Fill&& fill);
+
+private:
+    uint64_t _key;
+    uint32_t _high{0}; // Compteur de tirages : _high · 2^32 + _low
+    uint32_t _low{0};
+    uint32_t _offset{}; // Dérivés de _key et _high, recalculés tous les 2^32 tirages
+    uint32_t _mask{};
+};
+
+// Graine globale (--seed), à choisir avant le premier tirage ; sinon tirée au hasard au premier appel de random_seed()
+void     set_random_seed(uint64_t seed);
+uint64_t random_seed();
+// RandomStream{random_seed()}.split(thread_streams_id) est réservé aux flux de rand() : les autres numéros sont libres
+inline constexpr uint64_t thread_streams_id = ~uint64_t{0};
+
+// Tirages uniformes dans [min, max), dans le flux du thread appelant (dérivé de random_seed()).
+// Reproductibles tant que les tirages sont faits sur un seul thread ; pour des tirages en parallèle,
+// utiliser un RandomStream par tranche.
 float rand(float min, float max);
 void  draw_disk(glm::vec2 position, float radius, glm::vec4 const& color);
 void  draw_line(glm::vec2 start, glm::vec2 end, float thickness, glm::vec4 const& color);
@@ -14,8 +61,14 @@ std::optional<glm::vec2> segment_intersection(glm::vec2 p1, glm::vec2 p2, glm::v
 
 std::optional<glm::vec2> segment_circle_intersection(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius);
 
+// Tirage uniforme dans [min, max] (bornes comprises)
 int rand_int(int min, int max);
 
+// Remplit out de tirages uniformes, comme des appels successifs à rand() / rand_int(), mais en une boucle vectorisée :
+// à préférer pour créer beaucoup de particules d'un coup
+void rand_fill(std::span<float> out, float min, float max);
+void rand_fill(std::span<int> out, int min, int max);
+
 glm::vec2 lerp(glm::vec2 a, glm::vec2 b, float t);
 glm::vec2 bezier1(glm::vec2 p0, glm::vec2 p1, float t);
 glm::vec2 bezier2(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, float t);
@@ -26,7 +79,12 @@ glm::vec2 bezier2_bernstein(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, float t);
 glm::vec2 bezier3_bernstein(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, float t);
 
 glm::vec2 bezier3_derivative(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, float t);
+glm::vec2 bezier3_second_derivative(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, float t);
 
 float find_closest_t_on_bezier(glm::vec2 p, glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3);
 
+// Version par lots pour une même courbe : la forme polynomiale et les échantillons de la courbe sont calculés
+// une seule fois, puis simd::width points sont traités à la fois. t_out[i] et distance_out[i] correspondent à points[i].
+void find_closest_t_on_bezier(std::span<glm::vec2 const> points, glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, std::span<float> t_out, std::span<float> distance_out);
+
 } // namespace utils
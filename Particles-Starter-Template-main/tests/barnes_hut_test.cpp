@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "barnes_hut.hpp"
+#include "check.hpp"
+#include "utils.hpp"
+
+struct Reference {
+    glm::dvec2 acceleration;
+    double     magnitude; // Somme des normes des termes : l'échelle de l'erreur d'arrondi
+};
+
+// Somme directe en O(N²), en double, de la formule de BarnesHutTree::acceleration()
+static Reference direct_sum(std::vector<float> const& x, std::vector<float> const& y, glm::vec2 position, size_t exclude, float softening)
+{
+    double const epsilon_squared = static_cast<double>(softening) * softening;
+    Reference    reference{glm::dvec2{0.}, 0.};
+    for (size_t j = 0; j < x.size(); ++j)
+    {
+        if (j == exclude)
+            continue;
+        glm::dvec2 const to_particle = glm::dvec2{x[j], y[j]} - glm::dvec2{position};
+        double const     r2          = glm::dot(to_particle, to_particle) + epsilon_squared;
+        glm::dvec2 const term        = to_particle / (r2 * std::sqrt(r2));
+        reference.acceleration += term;
+        reference.magnitude += glm::length(term);
+    }
+    return reference;
+}
+
+static double error(glm::vec2 acceleration, Reference const& reference)
+{
+    return glm::length(glm::dvec2{acceleration} - reference.acceleration);
+}
+
+int main()
+{
+    utils::RandomStream random{16};
+    // Amas plus dense au centre (somme de trois uniformes), avec des particules superposées
+    std::vector<float> x{};
+    std::vector<float> y{};
+    for (int i = 0; i < 3000; ++i)
+    {
+        x.push_back(random.uniform(-1.f, 1.f) + random.uniform(-1.f, 1.f) + random.uniform(-1.f, 1.f));
+        y.push_back(random.uniform(-1.f, 1.f) + random.uniform(-1.f, 1.f) + random.uniform(-1.f, 1.f));
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+        x.push_back(0.25f);
+        y.push_back(0.5f);
+    }
+
+    BarnesHutTree tree{};
+    tree.build(x, y);
+
+    // theta = 0 : aucune cellule n'est approchée, c'est la somme directe (à l'ordre des additions près)
+    tree.theta         = 0.f;
+    double worst_exact = 0.;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        Reference const reference = direct_sum(x, y, {x[i], y[i]}, i, tree.softening);
+        worst_exact               = std::max(worst_exact, error(tree.acceleration({x[i], y[i]}, i), reference) / reference.magnitude);
+    }
+    // Point hors de l'amas, sans exclusion
+    Reference const far = direct_sum(x, y, {10.f, -7.f}, x.size(), tree.softening);
+    CHECK(error(tree.acceleration({10.f, -7.f}, x.size()), far) <= 1e-6 * far.magnitude);
+
+    // theta = 0.5 : erreur rapportée à la norme moyenne (quadratique) des forces exactes. Rapportée à la force de
+    // chaque particule, elle n'a pas de sens là où les attractions des deux côtés se compensent presque.
+    tree.theta = 0.5f;
+    std::vector<Reference> references{};
+    double                 mean_squared = 0.;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        references.push_back(direct_sum(x, y, {x[i], y[i]}, i, tree.softening));
+        mean_squared += glm::dot(references.back().acceleration, references.back().acceleration) / static_cast<double>(x.size());
+    }
+    double worst_approx = 0.;
+    double mean_approx  = 0.;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        double const relative = error(tree.acceleration({x[i], y[i]}, i), references[i]) / std::sqrt(mean_squared);
+        worst_approx          = std::max(worst_approx, relative);
+        mean_approx += relative / static_cast<double>(x.size());
+    }
+    std::cout << x.size() << " particules, " << tree.nodes_count() << " nœuds. theta = 0 : écart max " << worst_exact
+              << " (relatif aux termes). theta = 0.5 : erreur moyenne " << mean_approx << ", max " << worst_approx << "\n";
+    CHECK(worst_exact <= 1e-5); // Arrondi des sommes en float
+    CHECK(mean_approx <= 1e-2);
+    CHECK(worst_approx <= 3e-2);
+
+    // Particules superposées : chacune ne s'attire pas elle-même, les autres au même point ne comptent pas (distance nulle)
+    std::vector<float> const same_x(5, 1.f);
+    std::vector<float> const same_y(5, 2.f);
+    tree.build(same_x, same_y);
+    for (size_t i = 0; i < same_x.size(); ++i)
+        CHECK(tree.acceleration({1.f, 2.f}, i) == glm::vec2{0.f});
+    CHECK(error(tree.acceleration({1.f, 3.f}, same_x.size()), direct_sum(same_x, same_y, {1.f, 3.f}, same_x.size(), tree.softening)) <= 1e-6);
+
+    // Une seule particule : aucune force sur elle, la force exacte ailleurs
+    std::vector<float> const single_x{0.5f};
+    std::vector<float> const single_y{-0.5f};
+    tree.build(single_x, single_y);
+    CHECK(tree.acceleration({0.5f, -0.5f}, 0) == glm::vec2{0.f});
+    CHECK(error(tree.acceleration({0.f, 0.f}, 1), direct_sum(single_x, single_y, {0.f, 0.f}, 1, tree.softening)) <= 1e-6);
+
+    // Aucune particule
+    tree.build({}, {});
+    CHECK(tree.acceleration({0.f, 0.f}, 0) == glm::vec2{0.f});
+
+    return test_result();
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "check.hpp"
+#include "utils.hpp"
+
+// find_closest_t_on_bezier() par lots (SIMD) contre la version scalaire et contre un échantillonnage dense, sur
+// des courbes qui ont plusieurs minima locaux (en S, en boucle, presque dégénérées)
+int main()
+{
+    struct Bezier3 {
+        glm::vec2 p0, p1, p2, p3;
+    };
+    std::array<Bezier3, 5> const curves{{
+        {{-1.f, -1.f}, {-0.3f, 1.f}, {0.3f, -1.f}, {1.f, 1.f}},   // En S
+        {{-1.f, 0.f}, {1.5f, 1.f}, {-1.5f, 1.f}, {1.f, 0.f}},     // Boucle
+        {{-1.f, 0.f}, {2.f, 1.5f}, {2.f, -1.5f}, {-1.f, 0.1f}},   // Demi-tour, extrémités presque confondues
+        {{-1.f, -0.5f}, {1.f, 1.f}, {-1.f, 1.f}, {1.f, -0.5f}},   // Boucle serrée, presque une pointe
+        {{-1.f, 0.f}, {-0.33f, 0.f}, {0.33f, 0.f}, {1.f, 0.f}},   // Segment
+    }};
+
+    utils::RandomStream random{9};
+    static constexpr int dense_count  = 20'000;
+    static constexpr int points_count = 5001; // Pas un multiple de simd::width, pour passer aussi par un lot incomplet
+    int                  mismatches   = 0;
+    int                  misses       = 0;
+    for (Bezier3 const& curve : curves)
+    {
+        std::vector<glm::vec2> dense(dense_count + 1);
+        for (int i = 0; i <= dense_count; ++i)
+            dense[static_cast<size_t>(i)] = utils::bezier3_bernstein(curve.p0, curve.p1, curve.p2, curve.p3, static_cast<float>(i) / dense_count);
+
+        std::vector<glm::vec2> points(points_count);
+        for (glm::vec2& point : points)
+            point = {random.uniform(-1.5f, 1.5f), random.uniform(-1.5f, 1.5f)};
+
+        std::vector<float> t(points.size());
+        std::vector<float> distance(points.size());
+        utils::find_closest_t_on_bezier(points, curve.p0, curve.p1, curve.p2, curve.p3, t, distance);
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            glm::vec2 const point = points[i];
+            // Le t rendu correspond bien à la distance rendue
+            CHECK(std::abs(glm::distance(utils::bezier3_bernstein(curve.p0, curve.p1, curve.p2, curve.p3, t[i]), point) - distance[i]) < 1e-5f);
+
+            float const scalar_t        = utils::find_closest_t_on_bezier(point, curve.p0, curve.p1, curve.p2, curve.p3);
+            float const scalar_distance = glm::distance(utils::bezier3_bernstein(curve.p0, curve.p1, curve.p2, curve.p3, scalar_t), point);
+            if (std::abs(distance[i] - scalar_distance) > 1e-5f)
+            {
+                ++mismatches;
+                std::cerr << "Écart scalaire / lot en (" << point.x << ", " << point.y << ") : " << scalar_distance << " contre " << distance[i] << '\n';
+            }
+
+            // Deux minima à moins d'un écart entre échantillons l'un de l'autre ne se distinguent pas dans les 16
+            // échantillons : le mauvais peut être gardé, mais l'erreur reste petite devant cet écart
+            float dense_distance = INFINITY;
+            for (glm::vec2 sample : dense)
+                dense_distance = std::min(dense_distance, glm::distance(sample, point));
+            CHECK(distance[i] < dense_distance + 1e-3f);
+            if (distance[i] > dense_distance + 1e-5f)
+            {
+                ++misses;
+                std::cerr << "Minimum voisin gardé en (" << point.x << ", " << point.y << ") : " << distance[i] << " au lieu de " << dense_distance << '\n';
+            }
+        }
+    }
+    std::cout << curves.size() << " courbes, " << mismatches << " écart(s) scalaire / lot, " << misses << " minimum(s) voisin(s) gardé(s) au lieu du global\n";
+    CHECK(mismatches == 0);
+    CHECK(misses * 1000 < static_cast<int>(curves.size()) * points_count); // Moins d'un point sur mille
+    return test_result();
+}
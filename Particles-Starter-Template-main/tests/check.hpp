@@ -0,0 +1,27 @@
+#pragma once
+#include <iostream>
+
+// Vérifications minimales pour les tests : CHECK() affiche la condition qui échoue sans arrêter le test,
+// et main() rend test_result() (0 si toutes les vérifications sont passées), que ctest lit.
+inline int& failed_checks()
+{
+    static int count = 0;
+    return count;
+}
+
+#define CHECK(condition)                                                                      \
+    do                                                                                        \
+    {                                                                                         \
+        if (!(condition))                                                                     \
+        {                                                                                     \
+            ++failed_checks();                                                                \
+            std::cerr << __FILE__ << ':' << __LINE__ << " : échec de CHECK(" #condition ")\n"; \
+        }                                                                                     \
+    } while (false)
+
+inline int test_result()
+{
+    if (failed_checks() > 0)
+        std::cerr << failed_checks() << " vérification(s) en échec\n";
+    return failed_checks() > 0 ? 1 : 0;
+}
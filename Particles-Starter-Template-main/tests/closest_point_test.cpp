@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "check.hpp"
+#include "heart.hpp"
+#include "utils.hpp"
+
+// closest_point_on_heart() contre un échantillonnage dense de la courbe : la distance trouvée ne doit jamais
+// dépasser celle du meilleur échantillon (sinon le solveur a raté le minimum global)
+int main()
+{
+    static constexpr int dense_count = 100'000;
+    std::vector<glm::vec2> dense(dense_count);
+    for (int i = 0; i < dense_count; ++i)
+        dense[static_cast<size_t>(i)] = heart_curve(static_cast<float>(i) / dense_count);
+
+    auto const dense_distance = [&](glm::vec2 point) {
+        float best = INFINITY;
+        for (glm::vec2 sample : dense)
+            best = std::min(best, glm::distance(sample, point));
+        return best;
+    };
+
+    utils::RandomStream random{8};
+    std::vector<glm::vec2> points{};
+    // Points quelconques autour du cœur, y compris près du centre (plusieurs minima locaux presque égaux)
+    for (int i = 0; i < 2000; ++i)
+        points.push_back({random.uniform(-1.5f, 1.5f), random.uniform(-1.5f, 1.5f)});
+    // Points tout près de la courbe et près des deux pointes
+    for (int i = 0; i < 500; ++i)
+    {
+        float const t = random.uniform(0.f, 1.f);
+        points.push_back(heart_curve(t) + glm::vec2{random.uniform(-0.01f, 0.01f), random.uniform(-0.01f, 0.01f)});
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        glm::vec2 const tip = heart_curve(i % 2 == 0 ? 0.f : 0.5f);
+        points.push_back(tip + glm::vec2{random.uniform(-0.05f, 0.05f), random.uniform(-0.05f, 0.05f)});
+    }
+
+    long long evaluations = 0;
+    int       misses      = 0;
+    for (glm::vec2 point : points)
+    {
+        ClosestPoint const closest = closest_point_on_heart(point);
+        evaluations += closest.evaluations;
+        // Le t rendu correspond bien à la distance rendue
+        CHECK(std::abs(glm::distance(heart_curve(closest.t), point) - closest.distance) < 1e-5f);
+        if (closest.distance > dense_distance(point) + 1e-5f)
+        {
+            ++misses;
+            std::cerr << "Minimum raté en (" << point.x << ", " << point.y << ") : " << closest.distance << " au lieu de " << dense_distance(point) << '\n';
+        }
+    }
+    CHECK(misses == 0);
+
+    double const average = static_cast<double>(evaluations) / static_cast<double>(points.size());
+    std::cout << points.size() << " points, " << misses << " minimum(s) global(aux) raté(s), " << average << " évaluations en moyenne\n";
+    CHECK(average < 8.);
+
+    // Tangente : unitaire partout, et définie aux deux pointes où la dérivée s'annule
+    for (float t : {0.f, 0.25f, 0.5f, 0.75f, 0.999f})
+        CHECK(std::abs(glm::length(heart_tangent(t)) - 1.f) < 1e-4f);
+    return test_result();
+}
@@ -0,0 +1,159 @@
+#include <cmath>
+#include <iostream>
+#include <span>
+#include <vector>
+#include <glm/gtc/constants.hpp>
+#include "check.hpp"
+#include "simulation.hpp"
+
+// Point dans le polygone du cœur (parité du nombre de côtés traversés par une demi-droite horizontale)
+static bool is_inside(std::span<glm::vec2 const> polygon, glm::vec2 point)
+{
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+    {
+        glm::vec2 const a = polygon[i];
+        glm::vec2 const b = polygon[j];
+        if ((a.y > point.y) != (b.y > point.y) && point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y))
+            inside = !inside;
+    }
+    return inside;
+}
+
+// Particules lancées vers le cœur avec un grand dt : chaque pas traverserait le cœur de part en part sans les
+// collisions continues. Aucune ne doit finir à l'intérieur, et en rebondissant une particule ne parcourt pas
+// plus de chemin pendant un pas qu'elle n'en aurait parcouru en ligne droite.
+static void check_fast_particles()
+{
+    static constexpr int   particles_count = 2000;
+    static constexpr float dt              = 0.25f;
+    static constexpr float speed           = 6.f;
+    // Borne de l'accélération : poussée du cœur (au plus 5) + gravité
+    static constexpr float max_acceleration = 5.f + 0.4f;
+
+    Simulation simulation{particles_count, 1};
+    simulation.rain_per_step      = 0;
+    simulation.collide_with_heart = true;
+    simulation.prepare();
+
+    utils::RandomStream random{18};
+    for (int i = 0; i < particles_count; ++i)
+    {
+        // Départ sur un cercle autour du cœur, vers un point au hasard à l'intérieur
+        float const     angle    = random.uniform(0.f, glm::two_pi<float>());
+        glm::vec2 const start    = 1.4f * glm::vec2{std::cos(angle), std::sin(angle)};
+        glm::vec2 const target   = {random.uniform(-0.3f, 0.3f), random.uniform(-0.3f, 0.3f)};
+        glm::vec2 const velocity = speed * glm::normalize(target - start);
+        CHECK(!is_inside(simulation.heart_collider.points(), start));
+        simulation.particles.spawn(start, velocity);
+    }
+
+    std::span<glm::vec2 const> const polygon   = simulation.heart_collider.points().first(simulation.heart_collider.segments_count());
+    int                              inside    = 0;
+    int                              too_far   = 0;
+    std::vector<float>               start_speed{};
+    for (int step = 0; step < 20; ++step)
+    {
+        ParticleStore const& particles = simulation.particles;
+        size_t const         size      = particles.size();
+        start_speed.resize(size);
+        for (size_t i = 0; i < size; ++i)
+            start_speed[i] = glm::length(particles.velocity(i));
+
+        simulation.step(dt, 1.f);
+
+        for (size_t i = 0; i < particles.size(); ++i)
+        {
+            if (is_inside(polygon, particles.position(i)))
+            {
+                ++inside;
+                std::cerr << "Particule dans le cœur au pas " << step << " : (" << particles.position_x[i] << ", " << particles.position_y[i] << ")\n";
+            }
+        }
+        // Tant qu'aucune particule n'a été supprimée, les indices n'ont pas bougé
+        if (particles.size() != size)
+            continue;
+        for (size_t i = 0; i < size; ++i)
+        {
+            glm::vec2 const previous{particles.previous_position_x[i], particles.previous_position_y[i]};
+            if (glm::distance(previous, particles.position(i)) > (start_speed[i] + max_acceleration * dt) * dt + 1e-3f)
+                ++too_far;
+        }
+    }
+    std::cout << particles_count << " particules, " << inside << " dans le cœur, " << too_far << " déplacement(s) trop long(s)\n";
+    CHECK(inside == 0);
+    CHECK(too_far == 0);
+}
+
+// --collisions --solid-heart : la pluie s'empile sur le cœur, et les collisions entre particules poussent les plus
+// basses contre lui. Aucune ne doit être poussée à l'intérieur.
+static void check_pile_with_collisions()
+{
+    Simulation simulation{20'000, 7};
+    simulation.rain_per_step      = 400;
+    simulation.collide_particles  = true;
+    simulation.collide_with_heart = true;
+    simulation.prepare();
+
+    std::span<glm::vec2 const> const polygon = simulation.heart_collider.points().first(simulation.heart_collider.segments_count());
+    int                              inside  = 0;
+    for (int step = 0; step < 150; ++step)
+    {
+        simulation.step(1.f / 120.f, 16.f / 9.f);
+        ParticleStore const& particles = simulation.particles;
+        for (size_t i = 0; i < particles.size(); ++i)
+            inside += is_inside(polygon, particles.position(i));
+    }
+    std::cout << "Pile de " << simulation.particles.size() << " particules avec collisions : " << inside << " position(s) dans le cœur\n";
+    CHECK(inside == 0);
+}
+
+// --emitter --solid-heart : les particules de l'émetteur partent à l'extérieur du polygone des collisions (sinon elles
+// y restent enfermées), y compris dans le creux en haut du cœur
+static void check_heart_emitter()
+{
+    static constexpr int particles_count = 100'000;
+    {
+        // Tout le contour en un pas assez court pour que les particules n'aient pas bougé
+        static constexpr float dt = 1e-6f;
+        Simulation             simulation{particles_count, 25};
+        simulation.rain_per_step          = 0;
+        simulation.collide_with_heart     = true;
+        simulation.heart_emitter_per_step = particles_count;
+        simulation.heart_emitter_speed    = simulation.heart_outline.length() / dt;
+        simulation.step(dt, 1.f);
+
+        std::span<glm::vec2 const> const polygon = simulation.heart_collider.points().first(simulation.heart_collider.segments_count());
+        ParticleStore const&             particles = simulation.particles;
+        int                              inside    = 0;
+        for (size_t i = 0; i < particles.size(); ++i)
+            inside += is_inside(polygon, particles.position(i));
+        std::cout << particles.size() << " particules émises le long du contour, " << inside << " dans le cœur\n";
+        CHECK(particles.size() == particles_count);
+        CHECK(inside == 0);
+    }
+    {
+        Simulation simulation{particles_count, 25};
+        simulation.rain_per_step          = 0;
+        simulation.collide_with_heart     = true;
+        simulation.heart_emitter_per_step = 20;
+        for (int step = 0; step < 1200; ++step)
+            simulation.step(1.f / 120.f, 16.f / 9.f);
+
+        std::span<glm::vec2 const> const polygon = simulation.heart_collider.points().first(simulation.heart_collider.segments_count());
+        ParticleStore const&             particles = simulation.particles;
+        int                              inside    = 0;
+        for (size_t i = 0; i < particles.size(); ++i)
+            inside += is_inside(polygon, particles.position(i));
+        std::cout << "Émetteur après 1200 pas : " << particles.size() << " particules, " << inside << " dans le cœur\n";
+        CHECK(inside == 0);
+    }
+}
+
+int main()
+{
+    check_fast_particles();
+    check_pile_with_collisions();
+    check_heart_emitter();
+    return test_result();
+}
@@ -0,0 +1,60 @@
+#include <cmath>
+#include <iostream>
+#include "check.hpp"
+#include "integrate.hpp"
+#include "simd.hpp"
+#include "utils.hpp"
+
+// integrate() (SIMD, puis la fin avec integrate_scalar()) contre integrate_scalar() sur toutes les particules :
+// même résultat à 1e-6 près en relatif sur un pas (cf. integrate.hpp), y compris quand le nombre de particules
+// n'est pas un multiple de simd::width et quand la plage ne commence pas sur un paquet
+int main()
+{
+    static constexpr float dt        = 1.f / 120.f;
+    static constexpr float tolerance = 1e-6f;
+
+    utils::RandomStream random{3};
+    size_t const        count = 10 * simd::width + 3;
+    ParticleStore       particles{count};
+    for (size_t i = 0; i < count; ++i)
+    {
+        particles.spawn({random.uniform(-2.f, 2.f), random.uniform(-2.f, 2.f)}, {random.uniform(-5.f, 5.f), random.uniform(-5.f, 5.f)});
+        particles.acceleration_x[i] = random.uniform(-50.f, 50.f);
+        particles.acceleration_y[i] = random.uniform(-50.f, 50.f);
+    }
+
+    // Écart relatif à la taille des termes de la somme (un résultat proche de 0 peut venir de grands termes)
+    auto const close = [](float a, float b, float scale) { return std::abs(a - b) <= tolerance * scale; };
+
+    int mismatches = 0;
+    for (size_t begin : {size_t{0}, size_t{1}})
+    {
+        ParticleStore simd_path   = particles;
+        ParticleStore scalar_path = particles;
+        integrate(simd_path, begin, count, dt);
+        integrate_scalar(scalar_path, begin, count, dt);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            float const velocity_scale_x = std::abs(particles.velocity_x[i]) + std::abs(particles.acceleration_x[i] * dt);
+            float const velocity_scale_y = std::abs(particles.velocity_y[i]) + std::abs(particles.acceleration_y[i] * dt);
+            float const position_scale_x = std::abs(particles.position_x[i]) + std::abs(scalar_path.velocity_x[i] * dt);
+            float const position_scale_y = std::abs(particles.position_y[i]) + std::abs(scalar_path.velocity_y[i] * dt);
+            if (!close(simd_path.velocity_x[i], scalar_path.velocity_x[i], velocity_scale_x) ||
+                !close(simd_path.velocity_y[i], scalar_path.velocity_y[i], velocity_scale_y) ||
+                !close(simd_path.position_x[i], scalar_path.position_x[i], position_scale_x) ||
+                !close(simd_path.position_y[i], scalar_path.position_y[i], position_scale_y))
+            {
+                ++mismatches;
+                std::cerr << "Écart SIMD / scalaire pour la particule " << i << " (début " << begin << ")\n";
+            }
+        }
+        // Les particules avant begin ne bougent pas
+        for (size_t i = 0; i < begin; ++i)
+            CHECK(simd_path.position_x[i] == particles.position_x[i] && simd_path.velocity_x[i] == particles.velocity_x[i]);
+    }
+    std::cout << count << " particules (" << simd::instruction_set() << ", " << simd::width << " par paquet), "
+              << mismatches << " écart(s) SIMD / scalaire\n";
+    CHECK(mismatches == 0);
+    return test_result();
+}
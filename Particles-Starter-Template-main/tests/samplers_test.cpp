@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+#include "check.hpp"
+#include "samplers.hpp"
+#include "utils.hpp"
+
+static float cross(glm::vec2 a, glm::vec2 b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+// Aire du polygone (formule des trapèzes), quel que soit le sens du contour
+static float polygon_area(std::vector<glm::vec2> const& vertices)
+{
+    float signed_area = 0.f;
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+        signed_area += cross(vertices[j], vertices[i]);
+    return std::abs(signed_area) / 2.f;
+}
+
+// Centre de gravité du polygone plein, quel que soit le sens du contour
+static glm::vec2 polygon_centroid(std::vector<glm::vec2> const& vertices)
+{
+    float     signed_area = 0.f;
+    glm::vec2 sum{0.f};
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+    {
+        float const c = cross(vertices[j], vertices[i]);
+        signed_area += c;
+        sum += c * (vertices[j] + vertices[i]);
+    }
+    return sum / (3.f * signed_area);
+}
+
+// Dans le polygone (test de parité), ou à moins de tolerance d'un de ses côtés (arrondi des points sur le bord)
+static bool inside_polygon(std::vector<glm::vec2> const& vertices, glm::vec2 point, float tolerance)
+{
+    bool inside = false;
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+    {
+        glm::vec2 const a = vertices[j];
+        glm::vec2 const b = vertices[i];
+        if ((a.y > point.y) != (b.y > point.y) && point.x < a.x + (point.y - a.y) / (b.y - a.y) * (b.x - a.x))
+            inside = !inside;
+        float const t = std::clamp(glm::dot(point - a, b - a) / glm::dot(b - a, b - a), 0.f, 1.f);
+        if (glm::length(a + t * (b - a) - point) <= tolerance)
+            return true;
+    }
+    return inside;
+}
+
+// Tire des points dans le polygone : tous dedans, aire conservée par le découpage, centre de gravité des points
+// proche de celui du polygone
+static void check_polygon(std::vector<glm::vec2> const& vertices, char const* name)
+{
+    static constexpr size_t count = 100'000;
+
+    PolygonShape const polygon{vertices};
+    float const        area = polygon_area(vertices);
+    CHECK(std::abs(polygon.area() - area) <= 1e-5f * area);
+
+    utils::RandomStream random{23};
+    std::vector<float>  x(count);
+    std::vector<float>  y(count);
+    sample(polygon, random, x, y);
+
+    size_t    outside = 0;
+    glm::vec2 mean{0.f};
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!inside_polygon(vertices, {x[i], y[i]}, 1e-5f))
+            ++outside;
+        mean += glm::vec2{x[i], y[i]} / static_cast<float>(count);
+    }
+    // Écart type de la moyenne : de l'ordre de la taille du polygone / √count ≈ 0.006 ici, tolérance ≈ 3 écarts types
+    glm::vec2 const centroid = polygon_centroid(vertices);
+    std::cout << name << " : " << polygon.triangles().size() << " triangle(s), aire " << polygon.area() << " (" << area << " attendue), "
+              << outside << " point(s) dehors, centre (" << mean.x << ", " << mean.y << ") pour (" << centroid.x << ", " << centroid.y << ")\n";
+    CHECK(outside == 0);
+    CHECK(glm::length(mean - centroid) <= 0.02f);
+}
+
+int main()
+{
+    // En L (non convexe), dans le sens trigonométrique puis dans l'autre sens
+    std::vector<glm::vec2> l_shape{{0.f, 0.f}, {2.f, 0.f}, {2.f, 1.f}, {1.f, 1.f}, {1.f, 2.f}, {0.f, 2.f}};
+    check_polygon(l_shape, "L");
+    check_polygon({l_shape.rbegin(), l_shape.rend()}, "L à l'envers");
+
+    // Étoile à 5 branches : 5 sommets rentrants
+    std::vector<glm::vec2> star{};
+    for (int k = 0; k < 10; ++k)
+    {
+        float const angle  = std::numbers::pi_v<float> * (0.5f + static_cast<float>(k) / 5.f);
+        float const radius = k % 2 == 0 ? 1.f : 0.4f;
+        star.push_back(radius * glm::vec2{std::cos(angle), std::sin(angle)});
+    }
+    check_polygon(star, "étoile");
+    check_polygon({star.rbegin(), star.rend()}, "étoile à l'envers");
+
+    // Sommets alignés au milieu des côtés d'un carré, et un sommet rentrant aligné avec ses voisins
+    check_polygon({{0.f, 0.f}, {1.f, 0.f}, {2.f, 0.f}, {2.f, 1.f}, {2.f, 2.f}, {1.f, 2.f}, {0.f, 2.f}, {0.f, 1.f}}, "carré à sommets alignés");
+    check_polygon({{0.f, 0.f}, {3.f, 0.f}, {3.f, 2.f}, {2.f, 2.f}, {2.f, 1.f}, {1.5f, 1.f}, {1.f, 1.f}, {1.f, 2.f}, {0.f, 2.f}}, "U à sommets alignés");
+
+    // Entrées refusées
+    auto const rejected = [](std::vector<glm::vec2> vertices) {
+        try
+        {
+            PolygonShape{std::move(vertices)};
+        }
+        catch (std::invalid_argument const&)
+        {
+            return true;
+        }
+        return false;
+    };
+    CHECK(rejected({{0.f, 0.f}, {1.f, 0.f}}));
+    CHECK(rejected({{0.f, 0.f}, {1.f, 0.f}, {2.f, 0.f}, {3.f, 0.f}}));
+
+    // Disque par rejet : acceptation π / 4, tous les points dans le disque
+    DiskShape const     disk{{0.5f, -1.f}, 2.f};
+    utils::RandomStream random{24};
+    AcceptanceStats     stats{};
+    std::vector<float>  x(200'000);
+    std::vector<float>  y(200'000);
+    sample_disk_by_rejection(disk, random, x, y, stats);
+    size_t outside = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        if (glm::length(glm::vec2{x[i], y[i]} - disk.center) > disk.radius * (1.f + 1e-6f))
+            ++outside;
+    }
+    std::cout << "Disque par rejet : acceptation " << stats.rate() << " (π / 4 = " << std::numbers::pi / 4. << "), " << outside << " point(s) dehors\n";
+    CHECK(stats.accepted == x.size());
+    CHECK(std::abs(stats.rate() - std::numbers::pi / 4.) <= 0.005);
+    CHECK(outside == 0);
+
+    // Une forme qui n'accepte rien lève une exception au lieu de boucler sans fin
+    bool threw = false;
+    try
+    {
+        std::vector<float> few_x(10);
+        std::vector<float> few_y(10);
+        sample_by_rejection(RectangleShape{}, [](glm::vec2) { return false; }, random, few_x, few_y, stats);
+    }
+    catch (std::runtime_error const&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+
+    return test_result();
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+#include "check.hpp"
+#include "segment_bvh.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+
+// Impacts rapportés en testant la requête contre tous les murs, dans l'ordre attendu de SegmentBvh::intersect()
+static std::vector<SegmentHit> brute_force_hits(std::vector<Segment> const& walls, Segment query)
+{
+    glm::vec2 const         direction = query.end - query.start;
+    float const             length2   = glm::dot(direction, direction);
+    std::vector<SegmentHit> hits{};
+    for (uint32_t i = 0; i < walls.size(); ++i)
+    {
+        std::optional<glm::vec2> const point = utils::segment_intersection(query.start, query.end, walls[i].start, walls[i].end);
+        if (point)
+            hits.push_back({i, *point, length2 > 0.f ? glm::dot(*point - query.start, direction) / length2 : 0.f});
+    }
+    std::sort(hits.begin(), hits.end(), [](SegmentHit const& a, SegmentHit const& b) {
+        return a.fraction < b.fraction || (a.fraction == b.fraction && a.segment < b.segment);
+    });
+    return hits;
+}
+
+static std::vector<SegmentHit> brute_force_hits(std::vector<Segment> const& walls, Circle query)
+{
+    std::vector<SegmentHit> hits{};
+    for (uint32_t i = 0; i < walls.size(); ++i)
+    {
+        std::optional<glm::vec2> const point = utils::segment_circle_intersection(walls[i].start, walls[i].end, query.center, query.radius);
+        if (!point)
+            continue;
+        glm::vec2 const direction = walls[i].end - walls[i].start;
+        float const     length2   = glm::dot(direction, direction);
+        hits.push_back({i, *point, length2 > 0.f ? glm::dot(*point - walls[i].start, direction) / length2 : 0.f});
+    }
+    return hits; // Déjà triés par indice de segment
+}
+
+static bool same_hits(std::span<SegmentHit const> a, std::span<SegmentHit const> b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](SegmentHit const& x, SegmentHit const& y) {
+        return x.segment == y.segment && x.point == y.point && x.fraction == y.fraction;
+    });
+}
+
+// Compare les requêtes par lots au test de tous les murs, et à des requêtes une par une (le résultat d'un seul thread) ;
+// renvoie le nombre de requêtes qui diffèrent
+template<typename Query>
+static int count_mismatches(SegmentBvh const& bvh, std::vector<Segment> const& walls, std::vector<Query> const& queries, char const* name)
+{
+    SegmentHitLists batch{};
+    bvh.intersect(std::span<Query const>{queries}, batch);
+    CHECK(batch.size() == queries.size());
+
+    int    mismatches = 0;
+    size_t hits_count = 0;
+    for (size_t q = 0; q < queries.size(); ++q)
+    {
+        std::vector<SegmentHit> single{};
+        bvh.intersect(queries[q], single);
+        std::vector<SegmentHit> const expected = brute_force_hits(walls, queries[q]);
+        hits_count += expected.size();
+        if (!same_hits(batch[q], expected) || !same_hits(single, expected))
+        {
+            ++mismatches;
+            std::cerr << name << " " << q << " : " << expected.size() << " impact(s) attendu(s), " << batch[q].size()
+                      << " par lot, " << single.size() << " seule\n";
+        }
+    }
+    std::cout << queries.size() << " " << name << "s, " << hits_count << " impacts, " << mismatches << " différente(s) du test de tous les murs\n";
+    return mismatches;
+}
+
+int main()
+{
+    // Plusieurs threads même sur une machine à un cœur : les requêtes par lots sont réparties sur plusieurs tranches
+    set_thread_pool_size(4);
+
+    utils::RandomStream random{19};
+    auto const          random_point = [&] { return glm::vec2{random.uniform(-1.f, 1.f), random.uniform(-1.f, 1.f)}; };
+    auto const          random_step  = [&](float length) { return glm::vec2{random.uniform(-length, length), random.uniform(-length, length)}; };
+
+    // Murs courts, dont une part de verticaux et d'horizontaux (boîtes plates), et des requêtes de même taille
+    std::vector<Segment> walls{};
+    for (int i = 0; i < 3000; ++i)
+    {
+        glm::vec2 const start = random_point();
+        glm::vec2       end   = start + random_step(0.1f);
+        float const     kind  = random.uniform(0.f, 1.f);
+        if (kind < 0.1f)
+            end.x = start.x;
+        else if (kind < 0.2f)
+            end.y = start.y;
+        walls.push_back({start, end});
+    }
+    std::vector<Segment> motions{};
+    std::vector<Circle>  circles{};
+    for (int i = 0; i < 3000; ++i)
+    {
+        glm::vec2 const start = random_point();
+        motions.push_back({start, start + random_step(0.1f)});
+        circles.push_back({random_point(), random.uniform(0.f, 0.05f)});
+    }
+    // Requêtes réduites à un point
+    motions.push_back({walls[0].start, walls[0].start});
+    circles.push_back({walls[0].start, 0.f});
+
+    SegmentBvh bvh{};
+    bvh.build(walls);
+    CHECK(bvh.segments_count() == walls.size());
+
+    CHECK(count_mismatches(bvh, walls, motions, "déplacement") == 0);
+    CHECK(count_mismatches(bvh, walls, circles, "cercle") == 0);
+
+    // first_hit() : le premier impact du test de tous les murs
+    int first_mismatches = 0;
+    for (Segment const& motion : motions)
+    {
+        std::vector<SegmentHit> const   expected = brute_force_hits(walls, motion);
+        std::optional<SegmentHit> const first    = bvh.first_hit(motion);
+        bool const                      same     = expected.empty() ? !first.has_value() : first && same_hits({&*first, 1}, {expected.data(), 1});
+        if (!same)
+            ++first_mismatches;
+    }
+    std::cout << "first_hit() : " << first_mismatches << " différent(s) du premier impact\n";
+    CHECK(first_mismatches == 0);
+
+    // Arbre vide
+    SegmentBvh      empty{};
+    SegmentHitLists hits{};
+    empty.build({});
+    empty.intersect(std::span<Segment const>{motions}, hits);
+    CHECK(hits.size() == motions.size() && hits[0].empty());
+    CHECK(!empty.first_hit(motions[0]).has_value());
+
+    return test_result();
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+#include "segment_sweep.hpp"
+#include "utils.hpp"
+
+// Paires (first < second) rapportées par le test de toutes les paires avec utils::segment_intersection()
+static std::vector<std::pair<uint32_t, uint32_t>> brute_force_pairs(std::vector<Segment> const& segments)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> pairs{};
+    for (uint32_t a = 0; a < segments.size(); ++a)
+        for (uint32_t b = a + 1; b < segments.size(); ++b)
+            if (utils::segment_intersection(segments[a].start, segments[a].end, segments[b].start, segments[b].end))
+                pairs.emplace_back(a, b);
+    return pairs;
+}
+
+static std::vector<std::pair<uint32_t, uint32_t>> sweep_pairs(std::vector<Segment> const& segments)
+{
+    std::vector<SegmentIntersection> intersections{};
+    find_segment_intersections(segments, intersections);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs{};
+    for (SegmentIntersection const& intersection : intersections)
+        pairs.emplace_back(intersection.first, intersection.second);
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+// Compare le balayage au test de toutes les paires ; renvoie false (et affiche les écarts) s'ils diffèrent
+static bool matches_brute_force(std::vector<Segment> const& segments)
+{
+    auto const expected = brute_force_pairs(segments);
+    auto const found    = sweep_pairs(segments);
+    if (found == expected)
+        return true;
+    std::vector<std::pair<uint32_t, uint32_t>> missed{};
+    std::set_difference(expected.begin(), expected.end(), found.begin(), found.end(), std::back_inserter(missed));
+    std::vector<std::pair<uint32_t, uint32_t>> extra{};
+    std::set_difference(found.begin(), found.end(), expected.begin(), expected.end(), std::back_inserter(extra));
+    std::cerr << segments.size() << " segments : " << missed.size() << " paire(s) manquée(s), " << extra.size() << " en trop\n";
+    for (auto [a, b] : missed)
+    {
+        std::cerr << "  manquée : (" << segments[a].start.x << ", " << segments[a].start.y << ")-(" << segments[a].end.x << ", " << segments[a].end.y << ") × ("
+                  << segments[b].start.x << ", " << segments[b].start.y << ")-(" << segments[b].end.x << ", " << segments[b].end.y << ")\n";
+    }
+    return false;
+}
+
+int main()
+{
+    // Cas signalé : un segment presque vertical croise un segment en biais
+    CHECK(matches_brute_force({
+        {{0.9288f, 0.7743f}, {0.4058f, -0.7962f}},
+        {{0.4439f, -0.2343f}, {0.4440f, -0.8334f}},
+    }));
+
+    // Plusieurs segments par un même point, segments verticaux, extrémités communes
+    CHECK(matches_brute_force({
+        {{-1.f, -1.f}, {1.f, 1.f}},
+        {{-1.f, 1.f}, {1.f, -1.f}},
+        {{0.f, -1.f}, {0.f, 1.f}},
+        {{-1.f, 0.f}, {1.f, 0.f}},
+        {{0.f, 0.f}, {1.f, 0.5f}},
+        {{-0.5f, -1.f}, {-0.5f, 1.f}},
+        {{-0.5f, 0.5f}, {0.5f, 0.5f}},
+    }));
+
+    utils::RandomStream random{20};
+    auto const          random_point = [&] { return glm::vec2{random.uniform(-1.f, 1.f), random.uniform(-1.f, 1.f)}; };
+
+    int failures = 0;
+    int layouts  = 0;
+    // Dispositions au hasard, dont une part de segments presque verticaux, presque horizontaux ou qui partagent
+    // une extrémité
+    for (int layout = 0; layout < 2000; ++layout)
+    {
+        int const            count = 2 + static_cast<int>(random.uniform(0.f, 40.f));
+        std::vector<Segment> segments{};
+        for (int i = 0; i < count; ++i)
+        {
+            float const kind  = random.uniform(0.f, 1.f);
+            glm::vec2   start = random_point();
+            glm::vec2   end   = random_point();
+            if (kind < 0.2f) // Presque vertical
+                end.x = start.x + random.uniform(-1e-4f, 1e-4f);
+            else if (kind < 0.3f) // Vertical
+                end.x = start.x;
+            else if (kind < 0.4f) // Presque horizontal
+                end.y = start.y + random.uniform(-1e-4f, 1e-4f);
+            else if (kind < 0.5f && !segments.empty()) // Part d'une extrémité d'un autre segment
+                start = segments[static_cast<size_t>(random.uniform(0.f, static_cast<float>(segments.size()) - 0.5f))].end;
+            segments.push_back({start, end});
+        }
+        ++layouts;
+        if (!matches_brute_force(segments))
+            ++failures;
+    }
+    std::cout << layouts << " dispositions au hasard, " << failures << " différente(s) du test de toutes les paires\n";
+    CHECK(failures == 0);
+    return test_result();
+}